@@ -19,7 +19,7 @@
     nixpkgsFor = forAllSystems (system: import nixpkgs {inherit system;});
 
     # Remember to update this command every time it changes on the nob file!
-    schedulingBasicCompilation = ''clang $(pkg-config --cflags gtk4) $(pkg-config --libs gtk4) -g -O0 -Wall -o build/main src/main.c'';
+    schedulingBasicCompilation = ''clang $(pkg-config --cflags gtk4) $(pkg-config --libs gtk4) -g -O0 -Wall -o build/main src/main.c -lm -ldl'';
   in {
     devShells = forAllSystems (system: let
       pkgs = nixpkgsFor.${system};
@@ -9,13 +9,57 @@
 #define DEPS_FOLDER "deps/"
 
 #define HELP                                                                   \
-  "Usage: nob [-compiler options]\n"                                           \
+  "Usage: nob [-target] [-compiler options]\n"                                 \
   "If no options are provided the command will simply compile the "            \
   "application in debug mode.\n"                                               \
   "\n"                                                                         \
   "Compiler options:\n"                                                        \
   "* -b: Compile with optimization enabled.\n"                                 \
-  "* -v: Compile with verbosity enabled.\n"
+  "* -v: Compile with verbosity enabled.\n"                                    \
+  "\n"                                                                         \
+  "Targets:\n"                                                                 \
+  "* -c: Compile the headless CLI runner (" BUILD_FOLDER "cli) instead of "    \
+  "the application, it doesn't need GTK.\n"                                    \
+  "* -m: Compile the microbenchmarks (" BUILD_FOLDER "bench), always with "    \
+  "optimizations.\n"                                                           \
+  "* -w: Compile the workload generator (" BUILD_FOLDER "generate).\n"         \
+  "* -t: Compile the tests (" BUILD_FOLDER "tests), run them to check the "    \
+  "simulators.\n"                                                              \
+  "* -p: Compile the example scheduling policy plugin (" BUILD_FOLDER          \
+  "lcfs.so).\n"
+
+// Compiles a binary that only depends on lib.c, without GTK.
+bool compile_headless(const char *output, const char *source, bool verbose,
+                      bool optimized) {
+  Nob_Cmd cmd = {0};
+  nob_cmd_append(&cmd, "clang");
+  if (verbose) {
+    nob_cmd_append(&cmd, "-v");
+  }
+
+  if (optimized) {
+    nob_cmd_append(&cmd, "-O2", "-Werror");
+  } else {
+    nob_cmd_append(&cmd, "-g", "-O0");
+  }
+
+  nob_cmd_append(&cmd, "-Wall", "-o", output, source, "-lm", "-ldl");
+  return nob_cmd_run_sync_and_reset(&cmd);
+}
+
+// Compiles a scheduling policy plugin as a shared object.
+bool compile_plugin(const char *output, const char *source, bool verbose) {
+  Nob_Cmd cmd = {0};
+  nob_cmd_append(&cmd, "clang");
+  if (verbose) {
+    nob_cmd_append(&cmd, "-v");
+  }
+
+  // Plugins only include policy.h, so there's nothing else to link.
+  nob_cmd_append(&cmd, "-O2", "-Werror", "-Wall", "-shared", "-fPIC", "-o",
+                 output, source);
+  return nob_cmd_run_sync_and_reset(&cmd);
+}
 
 bool args_contains(int argc, char **argv, const char *arg, int arg_length) {
   if (argc <= 1) {
@@ -55,6 +99,46 @@ int main(int argc, char **argv) {
     return 1;
   }
 
+  if (args_contains(argc, argv, "-c", 2)) {
+    nob_log(NOB_INFO, "Compiling the headless CLI runner!");
+    return compile_headless(BUILD_FOLDER "cli", SRC_FOLDER "cli.c",
+                            compile_with_verbosity, compile_with_optimizations)
+               ? 0
+               : 1;
+  }
+
+  if (args_contains(argc, argv, "-m", 2)) {
+    nob_log(NOB_INFO, "Compiling the microbenchmarks!");
+    return compile_headless(BUILD_FOLDER "bench", SRC_FOLDER "bench.c",
+                            compile_with_verbosity, true)
+               ? 0
+               : 1;
+  }
+
+  if (args_contains(argc, argv, "-w", 2)) {
+    nob_log(NOB_INFO, "Compiling the workload generator!");
+    return compile_headless(BUILD_FOLDER "generate", SRC_FOLDER "generate.c",
+                            compile_with_verbosity, compile_with_optimizations)
+               ? 0
+               : 1;
+  }
+
+  if (args_contains(argc, argv, "-t", 2)) {
+    nob_log(NOB_INFO, "Compiling the tests!");
+    return compile_headless(BUILD_FOLDER "tests", SRC_FOLDER "tests.c",
+                            compile_with_verbosity, compile_with_optimizations)
+               ? 0
+               : 1;
+  }
+
+  if (args_contains(argc, argv, "-p", 2)) {
+    nob_log(NOB_INFO, "Compiling the example policy plugin!");
+    return compile_plugin(BUILD_FOLDER "lcfs.so", SRC_FOLDER "plugins/lcfs.c",
+                          compile_with_verbosity)
+               ? 0
+               : 1;
+  }
+
   Nob_Cmd cmd_res = {0};
   nob_cmd_append(&cmd_res, "bash", "-c",
                  "glib-compile-resources --sourcedir=./src/resources/ "
@@ -81,7 +165,7 @@ int main(int argc, char **argv) {
   }
 
   sb_append_cstr(&sb, "-Wall ");
-  sb_append_cstr(&sb, "-o " BUILD_FOLDER "main " SRC_FOLDER "main.c ");
+  sb_append_cstr(&sb, "-o " BUILD_FOLDER "main " SRC_FOLDER "main.c -lm -ldl ");
   sb_append_cstr(&sb, "");
   sb_append_null(&sb);
 
@@ -0,0 +1,778 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+
+// Every allocation done by lib.c goes through these, so the benchmarks can
+// count them. They must be defined after <stdlib.h> declares the real ones.
+static size_t BENCH_ALLOCATIONS = 0;
+
+static void *bench_malloc(size_t size) {
+  BENCH_ALLOCATIONS++;
+  return malloc(size);
+}
+
+static void *bench_realloc(void *ptr, size_t size) {
+  BENCH_ALLOCATIONS++;
+  return realloc(ptr, size);
+}
+
+static void *bench_calloc(size_t count, size_t size) {
+  BENCH_ALLOCATIONS++;
+  return calloc(count, size);
+}
+
+#define malloc(size) bench_malloc(size)
+#define realloc(ptr, size) bench_realloc(ptr, size)
+#define calloc(count, size) bench_calloc(count, size)
+#include "lib.c"
+#undef malloc
+#undef realloc
+#undef calloc
+
+// ################################
+// ||                            ||
+// ||         CONSTANTS          ||
+// ||                            ||
+// ################################
+
+#define HELP                                                                   \
+  "Usage: bench [options]\n"                                                   \
+  "Times the simulators, the file parser and the synchronization simulator "   \
+  "on generated workloads of 10 to n processes.\n"                             \
+  "\n"                                                                         \
+  "Options:\n"                                                                 \
+  "* -n <count>: Biggest workload, 1000000 by default.\n"                      \
+  "* -s <seed>: Seed of the generated workloads, 1 by default.\n"              \
+  "* -m: Only record metrics, instead of the steps the UI needs.\n"            \
+  "* -f <table|csv>: Output format, table by default.\n"                       \
+  "* -v: Keep the debug output of the simulators on stderr.\n"
+
+// Small workloads repeat until they simulate at least this many processes, so
+// their timings aren't dominated by the clock resolution.
+static const size_t BENCH_MIN_PROCESSES_PER_SAMPLE = 100000;
+// The synchronization simulator is much slower per process than the
+// schedulers, it stops growing here.
+static const size_t BENCH_MAX_SYNC_PROCESSES = 100000;
+static const int BENCH_SYNC_CYCLES = 32;
+static const int BENCH_QUANTUM = 4;
+static const SC_Time BENCH_AGING_INTERVAL = 10;
+static const size_t BENCH_MLFQ_LEVELS = 4;
+static const SC_Time BENCH_MLFQ_BOOST_INTERVAL = 1000;
+static const size_t BENCH_SMP_CPUS = 8;
+static const SC_Time BENCH_MIGRATION_COST = 2;
+// Switches pay a tick plus a cache refill that cools down with time away.
+static const SC_SwitchCost BENCH_SWITCH_COST = {
+    .switch_cost = 1,
+    .cache_refill = 4,
+    .cache_half_life = 16,
+};
+// Generated processes must complete within this many times their burst
+// time, so the real-time schedulers have deadlines to order.
+static const SC_Time BENCH_DEADLINE_FACTOR = 4;
+static const uint64_t BENCH_LOTTERY_SEED = 1;
+// The I/O workload splits every burst in two around an I/O burst this many
+// times longer than it, on one of these devices. Device 0 just sleeps.
+static const SC_Time BENCH_IO_FACTOR = 2;
+static const size_t BENCH_IO_DEVICES = 4;
+
+typedef enum {
+  BENCH_TABLE,
+  BENCH_CSV,
+} BenchFormat;
+
+/**
+ * What a benchmark measured for one workload size.
+ */
+typedef struct {
+  const char *name;
+  size_t processes;
+  size_t runs;
+  double ns_per_run;
+  /** Simulated time units, cycles for the synchronization simulator. */
+  uint64_t ticks;
+  size_t allocations_per_run;
+  /** Peak resident memory, in KiB. */
+  long peak_rss;
+  /**
+   * Jain's fairness index of the simulation, to compare how evenly the
+   * schedulers slow processes down at scale. 0 if nothing was scheduled.
+   */
+  float fairness;
+} BenchResult;
+
+// ################################
+// ||                            ||
+// ||         MEASURING          ||
+// ||                            ||
+// ################################
+
+static uint64_t bench_now_ns(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+// Tries to reset the peak resident memory, so every benchmark reports its own.
+// Only Linux supports it, otherwise the peak of the whole run is reported.
+static void bench_reset_peak_rss(void) {
+  FILE *file = fopen("/proc/self/clear_refs", "w");
+  if (NULL != file) {
+    fputs("5", file);
+    fclose(file);
+  }
+}
+
+// Returns the peak resident memory in KiB.
+static long bench_peak_rss(void) {
+  FILE *file = fopen("/proc/self/status", "r");
+  if (NULL != file) {
+    char line[256];
+    long peak = -1;
+    while (fgets(line, sizeof(line), file)) {
+      if (sscanf(line, "VmHWM: %ld kB", &peak) == 1) {
+        break;
+      }
+    }
+    fclose(file);
+    if (peak >= 0) {
+      return peak;
+    }
+  }
+
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+static size_t bench_runs_for(size_t processes) {
+  size_t runs = BENCH_MIN_PROCESSES_PER_SAMPLE / processes;
+  return runs > 0 ? runs : 1;
+}
+
+// ################################
+// ||                            ||
+// ||         WORKLOADS          ||
+// ||                            ||
+// ################################
+
+/**
+ * Fills `processes` with `n` random processes.
+ *
+ * Processes arrive twice as fast as the CPU can run them, which keeps the
+ * ready queues long.
+ */
+static void bench_generate_processes(SC_ProcessTable *processes, size_t n,
+                                     uint64_t seed, SC_Err err) {
+  SC_WorkloadConfig config = SC_WorkloadConfig_Default();
+  config.mean_interarrival = config.mean_burst / 2;
+
+  SC_Workload workload;
+  SC_Workload_Init(&workload, config, seed);
+  SC_ProcessTable_Reset(processes);
+  for (size_t i = 0; i < n; i++) {
+    SC_Process process = SC_Workload_Next(&workload);
+    process.deadline = process.burst_time * BENCH_DEADLINE_FACTOR;
+    SC_ProcessTable_Append(processes, process, err);
+    if (*err != NO_ERROR) {
+      return;
+    }
+  }
+}
+
+/**
+ * Copies `processes` into `io_processes`, splitting the burst of each one in
+ * two CPU bursts around an I/O burst.
+ */
+static void bench_split_io(SC_ProcessTable *processes,
+                           SC_ProcessTable *io_processes, SC_Err err) {
+  SC_ProcessTable_Reset(io_processes);
+  for (size_t i = 0; i < processes->count; i++) {
+    SC_Process process = SC_ProcessTable_Get(processes, i);
+    SC_Time burst = process.burst_time;
+    if (burst >= 2) {
+      SC_IoCycle cycles[2] = {
+          {
+              .cpu_time = burst / 2,
+              .io_time = burst * BENCH_IO_FACTOR,
+              .device = i % BENCH_IO_DEVICES,
+          },
+          {.cpu_time = burst - burst / 2},
+      };
+      process.io_time = cycles[0].io_time;
+      process.first_cycle = io_processes->cycles.length;
+      process.cycle_count = 2;
+      for (int c = 0; c < 2 && *err == NO_ERROR; c++) {
+        SC_ProcessTable_AppendCycle(io_processes, cycles[c], err);
+      }
+    }
+
+    if (*err == NO_ERROR) {
+      SC_ProcessTable_Append(io_processes, process, err);
+    }
+    if (*err != NO_ERROR) {
+      return;
+    }
+  }
+}
+
+// Writes `processes` on the `P, burst, arrival, priority` format.
+static SC_String bench_format_processes(SC_ProcessTable *processes) {
+  // The longest line is `P` + 20 digits, 3 separators, 2 * 20 digits and 10.
+  size_t capacity = processes->count * 80 + 1;
+  SC_String text = {.data = malloc(capacity), .data_capacity = capacity};
+  if (NULL == text.data) {
+    return text;
+  }
+
+  for (size_t i = 0; i < processes->count; i++) {
+    text.length += snprintf(
+        text.data + text.length, capacity - text.length,
+        "P%zu, %" PRIu64 ", %" PRIu64 ", %u\n", i, processes->burst_time[i],
+        processes->arrival_time[i], processes->priority[i]);
+  }
+  return text;
+}
+
+// ################################
+// ||                            ||
+// ||         SCHEDULERS         ||
+// ||                            ||
+// ################################
+
+typedef enum {
+  BENCH_FIFO,
+  BENCH_SJF,
+  BENCH_HRRN,
+  BENCH_SRT,
+  BENCH_RR,
+  BENCH_RR_SWITCH,
+  BENCH_PRIORITY,
+  BENCH_PRIORITY_PREEMPTIVE,
+  /** The same policies through their callbacks, like a plugin's. */
+  BENCH_FIFO_GENERIC,
+  BENCH_SJF_GENERIC,
+  BENCH_PRIORITY_GENERIC,
+  BENCH_MLFQ,
+  BENCH_CFS,
+  BENCH_EDF,
+  BENCH_RM,
+  BENCH_LOTTERY,
+  BENCH_STRIDE,
+  BENCH_SMP,
+  /** Runs on the table with I/O bursts. */
+  BENCH_SMP_IO,
+  BENCH_SCHEDULER_COUNT,
+} BenchScheduler;
+
+static const char *BENCH_SCHEDULER_NAMES[BENCH_SCHEDULER_COUNT] = {
+    "simulate_first_in_first_out",     "simulate_shortest_first",
+    "simulate_highest_response_ratio", "simulate_shortest_remaining",
+    "simulate_round_robin",            "simulate_round_robin (switches)",
+    "simulate_priority",               "simulate_priority_preemptive",
+    "simulate_policy (FIFO)",          "simulate_policy (SJF)",
+    "simulate_policy (Priority)",      "simulate_multilevel_feedback",
+    "simulate_completely_fair",        "simulate_real_time (EDF)",
+    "simulate_real_time (RM)",         "simulate_lottery",
+    "simulate_stride",                 "simulate_smp (RR, 8 CPUs)",
+    "simulate_smp (SRT, I/O, 8 CPUs)",
+};
+
+// The built-in policies, looked up by name like the ones of a plugin so the
+// compiler can't specialise the engine for them.
+static SC_PolicyRegistry BENCH_POLICIES;
+
+static void bench_register_policies(SC_Err err) {
+  SC_PolicyRegistry_Init(&BENCH_POLICIES);
+  SC_PolicyRegistry_Register(&BENCH_POLICIES, &SC_FIFO_POLICY, err);
+  SC_PolicyRegistry_Register(&BENCH_POLICIES, &SC_SHORTEST_FIRST_POLICY, err);
+  SC_PolicyRegistry_Register(&BENCH_POLICIES, &SC_PRIORITY_POLICY, err);
+}
+
+static void bench_run_scheduler(BenchScheduler scheduler,
+                                SC_ProcessTable *processes, SC_Simulation *sim,
+                                SC_Err err) {
+  switch (scheduler) {
+  case BENCH_FIFO:
+    simulate_first_in_first_out(processes, sim, err);
+    break;
+  case BENCH_SJF:
+    simulate_shortest_first(processes, sim, err);
+    break;
+  case BENCH_HRRN:
+    simulate_highest_response_ratio(processes, sim, err);
+    break;
+  case BENCH_SRT:
+    simulate_shortest_remaining(processes, sim, err);
+    break;
+  case BENCH_RR:
+    simulate_round_robin(processes, sim, BENCH_QUANTUM, err);
+    break;
+  case BENCH_RR_SWITCH:
+    sim->switch_cost = BENCH_SWITCH_COST;
+    simulate_round_robin(processes, sim, BENCH_QUANTUM, err);
+    break;
+  case BENCH_PRIORITY:
+    simulate_priority(processes, sim, err);
+    break;
+  case BENCH_PRIORITY_PREEMPTIVE:
+    simulate_priority_preemptive(processes, sim, BENCH_AGING_INTERVAL, err);
+    break;
+  case BENCH_FIFO_GENERIC:
+    simulate_policy(processes, sim,
+                    SC_PolicyRegistry_Find(&BENCH_POLICIES, "fifo"), err);
+    break;
+  case BENCH_SJF_GENERIC:
+    simulate_policy(processes, sim,
+                    SC_PolicyRegistry_Find(&BENCH_POLICIES, "sjf"), err);
+    break;
+  case BENCH_PRIORITY_GENERIC:
+    simulate_policy(processes, sim,
+                    SC_PolicyRegistry_Find(&BENCH_POLICIES, "priority"), err);
+    break;
+  case BENCH_MLFQ: {
+    SC_MlfqConfig config = SC_MlfqConfig_Doubling(
+        BENCH_MLFQ_LEVELS, BENCH_QUANTUM, BENCH_MLFQ_BOOST_INTERVAL);
+    simulate_multilevel_feedback(processes, sim, &config, err);
+  } break;
+  case BENCH_CFS: {
+    SC_CfsConfig config = SC_CfsConfig_Default();
+    simulate_completely_fair(processes, sim, &config, err);
+  } break;
+  case BENCH_EDF:
+  case BENCH_RM: {
+    SC_RtConfig config = SC_RtConfig_Default(
+        scheduler == BENCH_EDF ? SC_RT_EARLIEST_DEADLINE
+                               : SC_RT_RATE_MONOTONIC,
+        processes);
+    simulate_real_time(processes, sim, &config, err);
+  } break;
+  case BENCH_LOTTERY:
+    simulate_lottery(processes, sim, BENCH_QUANTUM, BENCH_LOTTERY_SEED, err);
+    break;
+  case BENCH_STRIDE:
+    simulate_stride(processes, sim, BENCH_QUANTUM, err);
+    break;
+  case BENCH_SMP: {
+    SC_SmpConfig config = {
+        .policy = SC_SMP_ROUND_ROBIN,
+        .cpu_count = BENCH_SMP_CPUS,
+        .quantum = BENCH_QUANTUM,
+        .migration_cost = BENCH_MIGRATION_COST,
+    };
+    simulate_smp(processes, sim, &config, err);
+  } break;
+  case BENCH_SMP_IO: {
+    SC_SmpConfig config = {
+        .policy = SC_SMP_SHORTEST_REMAINING,
+        .cpu_count = BENCH_SMP_CPUS,
+        .migration_cost = BENCH_MIGRATION_COST,
+    };
+    simulate_smp(processes, sim, &config, err);
+  } break;
+  default:
+    SC_PANIC("Unknown scheduler %d!", scheduler);
+  }
+}
+
+static BenchResult bench_scheduler(BenchScheduler scheduler,
+                                   SC_ProcessTable *processes,
+                                   SC_RecordMode record_mode, SC_Err err) {
+  BenchResult result = {
+      .name = BENCH_SCHEDULER_NAMES[scheduler],
+      .processes = processes->count,
+      .runs = bench_runs_for(processes->count),
+  };
+
+  bench_reset_peak_rss();
+  BENCH_ALLOCATIONS = 0;
+  uint64_t start = bench_now_ns();
+  for (size_t run = 0; run < result.runs; run++) {
+    SC_Simulation sim = {.record_mode = record_mode};
+    bench_run_scheduler(scheduler, processes, &sim, err);
+    result.ticks = sim.makespan;
+    result.fairness = sim.fairness;
+    SC_Simulation_Deinit(&sim);
+    if (*err != NO_ERROR) {
+      break;
+    }
+  }
+  uint64_t elapsed = bench_now_ns() - start;
+
+  result.ns_per_run = (double)elapsed / result.runs;
+  result.allocations_per_run = BENCH_ALLOCATIONS / result.runs;
+  result.peak_rss = bench_peak_rss();
+  return result;
+}
+
+/**
+ * Sorts the arrivals of `processes` like the simulators do, with
+ * `SC_HeapEntry_Sort` or, to compare, with `qsort` and a comparator.
+ */
+static BenchResult bench_sort(SC_ProcessTable *processes, SC_Bool use_qsort,
+                              SC_Err err) {
+  size_t n = processes->count;
+  BenchResult result = {
+      .name = use_qsort ? "qsort (arrivals)" : "SC_HeapEntry_Sort (arrivals)",
+      .processes = n,
+      .runs = bench_runs_for(n),
+  };
+
+  SC_HeapEntry *arrivals = malloc(sizeof(SC_HeapEntry) * n);
+  if (NULL == arrivals) {
+    *err = MALLOC_FAILED;
+    return result;
+  }
+
+  bench_reset_peak_rss();
+  BENCH_ALLOCATIONS = 0;
+  uint64_t start = bench_now_ns();
+  for (size_t run = 0; run < result.runs; run++) {
+    for (size_t i = 0; i < n; i++) {
+      arrivals[i] =
+          (SC_HeapEntry){.key = processes->arrival_time[i], .idx = i};
+    }
+    if (use_qsort) {
+      qsort(arrivals, n, sizeof(SC_HeapEntry), SC_HeapEntry_Compare);
+    } else {
+      SC_HeapEntry_Sort(arrivals, n);
+    }
+  }
+  uint64_t elapsed = bench_now_ns() - start;
+
+  free(arrivals);
+  result.ns_per_run = (double)elapsed / result.runs;
+  result.allocations_per_run = BENCH_ALLOCATIONS / result.runs;
+  result.peak_rss = bench_peak_rss();
+  return result;
+}
+
+static BenchResult bench_parser(SC_ProcessTable *processes, SC_Err err) {
+  BenchResult result = {
+      .name = "parse_scheduling_file",
+      .processes = processes->count,
+      .runs = bench_runs_for(processes->count),
+  };
+
+  SC_String text = bench_format_processes(processes);
+  if (NULL == text.data) {
+    *err = MALLOC_FAILED;
+    return result;
+  }
+
+  SC_ProcessTable parsed = {0};
+  bench_reset_peak_rss();
+  BENCH_ALLOCATIONS = 0;
+  uint64_t start = bench_now_ns();
+  for (size_t run = 0; run < result.runs; run++) {
+    struct SC_Arena pids_arena = {0};
+    SC_StringList pid_list = {0};
+    SC_StringList_Init(&pid_list);
+    SC_Arena_Init(&pids_arena, 1024, err);
+    if (*err == NO_ERROR) {
+      SC_ProcessTable_Init(&parsed, 64, err);
+    }
+    if (*err == NO_ERROR) {
+      parse_scheduling_file(&text, &pids_arena, &pid_list, &parsed, err);
+    }
+
+    SC_ProcessTable_Deinit(&parsed);
+    SC_Arena_Deinit(&pids_arena);
+    if (*err != NO_ERROR) {
+      break;
+    }
+  }
+  uint64_t elapsed = bench_now_ns() - start;
+
+  free(text.data);
+  result.ns_per_run = (double)elapsed / result.runs;
+  result.allocations_per_run = BENCH_ALLOCATIONS / result.runs;
+  result.peak_rss = bench_peak_rss();
+  return result;
+}
+
+// ################################
+// ||                            ||
+// ||      SYNCHRONIZATION       ||
+// ||                            ||
+// ################################
+
+/**
+ * Builds a semaphore simulation with `n` processes that compete for one
+ * resource per 10 processes, every process tries to access its resource
+ * once on a random cycle.
+ */
+static void bench_sync_init(SC_SyncSimulator *simulator, size_t n,
+                            uint64_t seed, SC_Err err) {
+  SC_Random random;
+  SC_Random_Init(&random, seed);
+  int resource_count = n / 10 > 0 ? n / 10 : 1;
+
+  *simulator = (SC_SyncSimulator){
+      .process_count = n,
+      .resource_count = resource_count,
+      .timeline_count = n,
+      .simulation_running = SC_TRUE,
+      .sync_type = SYNC_SEMAPHORE,
+      .semaphore_count = 2,
+  };
+  simulator->processes = calloc(n, sizeof(SC_SyncProcess));
+  simulator->resources = calloc(resource_count, sizeof(SC_Resource));
+  simulator->process_timelines = calloc(n, sizeof(SC_ProcessTimeline));
+  if (!simulator->processes || !simulator->resources ||
+      !simulator->process_timelines) {
+    *err = MALLOC_FAILED;
+    return;
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    simulator->processes[i] = (SC_SyncProcess){
+        .id = i,
+        .burst_time = BENCH_SYNC_CYCLES * 2,
+        .arrival_time = SC_Random_Next(&random) % BENCH_SYNC_CYCLES,
+        .priority = SC_Random_Next(&random) % 10,
+        .current_state = STATE_READY,
+    };
+    simulator->process_timelines[i].id = i;
+    SC_Slice_init(&simulator->process_timelines[i].entries,
+                  sizeof(SC_ProcessTimelineEntry), 8, err);
+    if (*err != NO_ERROR) {
+      return;
+    }
+  }
+
+  for (int r = 0; r < resource_count; r++) {
+    SC_Resource *resource = &simulator->resources[r];
+    size_t first = r * n / resource_count;
+    size_t last = (r + 1) * n / resource_count;
+    *resource = (SC_Resource){
+        .id = r,
+        .counter = 2,
+        .max_counter = 2,
+        .actions = calloc(last - first, sizeof(SC_Action)),
+        .action_count = last - first,
+    };
+    if (NULL == resource->actions) {
+      *err = MALLOC_FAILED;
+      return;
+    }
+
+    for (size_t i = first; i < last; i++) {
+      resource->actions[i - first] = (SC_Action){
+          .id = i,
+          .pid = i,
+          .resource_id = r,
+          .cycle = 1 + SC_Random_Next(&random) % BENCH_SYNC_CYCLES,
+          .priority = simulator->processes[i].priority,
+      };
+    }
+  }
+}
+
+static void bench_sync_deinit(SC_SyncSimulator *simulator) {
+  for (int i = 0; i < simulator->timeline_count; i++) {
+    SC_Slice_deinit(&simulator->process_timelines[i].entries);
+  }
+  for (int r = 0; r < simulator->resource_count; r++) {
+    free(simulator->resources[r].actions);
+  }
+  free(simulator->processes);
+  free(simulator->resources);
+  free(simulator->process_timelines);
+}
+
+static BenchResult bench_sync(size_t n, uint64_t seed, SC_Err err) {
+  BenchResult result = {
+      .name = "SC_SyncSimulator_next",
+      .processes = n,
+      .runs = 1,
+      .ticks = BENCH_SYNC_CYCLES,
+  };
+
+  SC_SyncSimulator simulator;
+  bench_sync_init(&simulator, n, seed, err);
+  if (*err != NO_ERROR) {
+    bench_sync_deinit(&simulator);
+    return result;
+  }
+
+  bench_reset_peak_rss();
+  BENCH_ALLOCATIONS = 0;
+  uint64_t start = bench_now_ns();
+  for (int cycle = 0; cycle < BENCH_SYNC_CYCLES; cycle++) {
+    SC_SyncSimulator_next(&simulator, err);
+    if (*err != NO_ERROR) {
+      break;
+    }
+  }
+  uint64_t elapsed = bench_now_ns() - start;
+
+  result.ns_per_run = (double)elapsed;
+  result.allocations_per_run = BENCH_ALLOCATIONS;
+  result.peak_rss = bench_peak_rss();
+  bench_sync_deinit(&simulator);
+  return result;
+}
+
+// ################################
+// ||                            ||
+// ||            MAIN            ||
+// ||                            ||
+// ################################
+
+static void bench_print_header(BenchFormat format) {
+  if (format == BENCH_CSV) {
+    printf("benchmark,processes,runs,ms_per_run,ns_per_process,ns_per_tick,"
+           "allocations_per_run,peak_rss_kib,fairness\n");
+    return;
+  }
+
+  printf("%-32s %9s %6s %12s %12s %12s %10s %12s %8s\n", "benchmark",
+         "processes", "runs", "ms/run", "ns/process", "ns/tick", "allocs/run",
+         "peak RSS KiB", "fairness");
+}
+
+static void bench_print_result(BenchFormat format, BenchResult *result) {
+  double ns_per_process = result->ns_per_run / result->processes;
+  double ns_per_tick =
+      result->ticks > 0 ? result->ns_per_run / result->ticks : 0;
+
+  // The parser doesn't simulate any time.
+  char ticks[32] = "-";
+  if (result->ticks > 0) {
+    snprintf(ticks, sizeof(ticks), "%.2f", ns_per_tick);
+  } else if (format == BENCH_CSV) {
+    ticks[0] = 0;
+  }
+
+  char fairness[32] = "-";
+  if (result->fairness > 0) {
+    snprintf(fairness, sizeof(fairness), "%.4f", result->fairness);
+  } else if (format == BENCH_CSV) {
+    fairness[0] = 0;
+  }
+
+  if (format == BENCH_CSV) {
+    printf("%s,%zu,%zu,%.4f,%.2f,%s,%zu,%ld,%s\n", result->name,
+           result->processes, result->runs, result->ns_per_run / 1e6,
+           ns_per_process, ticks, result->allocations_per_run,
+           result->peak_rss, fairness);
+  } else {
+    printf("%-32s %9zu %6zu %12.4f %12.2f %12s %10zu %12ld %8s\n",
+           result->name, result->processes, result->runs,
+           result->ns_per_run / 1e6, ns_per_process, ticks,
+           result->allocations_per_run, result->peak_rss, fairness);
+  }
+  fflush(stdout);
+}
+
+int main(int argc, char **argv) {
+  size_t max_processes = 1000000;
+  uint64_t seed = 1;
+  SC_RecordMode record_mode = SC_RECORD_STEPS;
+  BenchFormat format = BENCH_TABLE;
+  SC_Bool verbose = SC_FALSE;
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+    if (strcmp(arg, "-m") == 0) {
+      record_mode = SC_RECORD_METRICS;
+    } else if (strcmp(arg, "-v") == 0) {
+      verbose = SC_TRUE;
+    } else if (strcmp(arg, "-n") == 0 && NULL != value) {
+      max_processes = strtoull(value, NULL, 10);
+      i++;
+    } else if (strcmp(arg, "-s") == 0 && NULL != value) {
+      seed = strtoull(value, NULL, 10);
+      i++;
+    } else if (strcmp(arg, "-f") == 0 && NULL != value &&
+               (strcmp(value, "table") == 0 || strcmp(value, "csv") == 0)) {
+      format = strcmp(value, "csv") == 0 ? BENCH_CSV : BENCH_TABLE;
+      i++;
+    } else {
+      fprintf(stderr, HELP);
+      return 1;
+    }
+  }
+
+  // The synchronization simulator prints every cycle, which would be timed
+  // too.
+  if (!verbose && NULL == freopen("/dev/null", "w", stderr)) {
+    fprintf(stdout, "ERROR: Can't silence stderr, run with -v!\n");
+    return 1;
+  }
+
+  size_t err = NO_ERROR;
+  SC_ProcessTable processes = {0};
+  SC_ProcessTable io_processes = {0};
+  SC_ProcessTable_Init(&processes, 64, &err);
+  if (err == NO_ERROR) {
+    SC_ProcessTable_Init(&io_processes, 64, &err);
+  }
+  if (err == NO_ERROR) {
+    bench_register_policies(&err);
+  }
+  if (err != NO_ERROR) {
+    fprintf(stdout, "ERROR: %s\n", SC_Err_ToString(&err));
+    return 1;
+  }
+
+  bench_print_header(format);
+  for (size_t n = 10; n <= max_processes; n *= 10) {
+    bench_generate_processes(&processes, n, seed, &err);
+    if (err == NO_ERROR) {
+      bench_split_io(&processes, &io_processes, &err);
+    }
+    if (err != NO_ERROR) {
+      break;
+    }
+
+    for (int scheduler = 0; scheduler < BENCH_SCHEDULER_COUNT; scheduler++) {
+      SC_ProcessTable *table =
+          scheduler == BENCH_SMP_IO ? &io_processes : &processes;
+      BenchResult result = bench_scheduler(scheduler, table, record_mode, &err);
+      if (err != NO_ERROR) {
+        break;
+      }
+      bench_print_result(format, &result);
+    }
+    if (err != NO_ERROR) {
+      break;
+    }
+
+    for (int use_qsort = 1; use_qsort >= 0; use_qsort--) {
+      BenchResult result = bench_sort(&processes, use_qsort, &err);
+      if (err != NO_ERROR) {
+        break;
+      }
+      bench_print_result(format, &result);
+    }
+    if (err != NO_ERROR) {
+      break;
+    }
+
+    BenchResult result = bench_parser(&processes, &err);
+    if (err != NO_ERROR) {
+      break;
+    }
+    bench_print_result(format, &result);
+
+    if (n <= BENCH_MAX_SYNC_PROCESSES) {
+      result = bench_sync(n, seed, &err);
+      if (err != NO_ERROR) {
+        break;
+      }
+      bench_print_result(format, &result);
+    }
+  }
+
+  SC_ProcessTable_Deinit(&processes);
+  SC_ProcessTable_Deinit(&io_processes);
+  if (err != NO_ERROR) {
+    fprintf(stdout, "ERROR: %s\n", SC_Err_ToString(&err));
+    return 1;
+  }
+  return 0;
+}
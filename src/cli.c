@@ -0,0 +1,619 @@
+#include "lib.c"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ################################
+// ||                            ||
+// ||         CONSTANTS          ||
+// ||                            ||
+// ################################
+
+#define HELP                                                                   \
+  "Usage: cli [options] <file>\n"                                              \
+  "Simulates the scheduling algorithms on a `P, burst, arrival, priority` "    \
+  "file and prints their metrics. Real-time tasks can add `, period, "         \
+  "deadline` columns, and processes that do I/O list their bursts, like "      \
+  "`4 1:3 5` for 4 on the CPU, 3 on device 1 and 5 on the CPU. Only fifo, "    \
+  "sjf, srt, rr and priority without aging model the I/O.\n"                   \
+  "\n"                                                                         \
+  "Options:\n"                                                                 \
+  "* -a <algorithms>: Comma separated list of algorithms to run, from "        \
+  "fifo, sjf, hrrn, srt, rr, priority, mlfq, cfs, edf, rm, lottery and "       \
+  "stride. All of them by default.\n"                                          \
+  "* -q <quantum>: Quantum of Round Robin, lottery and stride, 4 by "          \
+  "default.\n"                                                                 \
+  "* -s <seed>: Seed of the lottery draws, 1 by default.\n"                    \
+  "* -p: Run Priority preemptively.\n"                                         \
+  "* -g <interval>: Aging interval of preemptive Priority, 0 disables it.\n"   \
+  "* -L <quanta>: Comma separated quantum of each MLFQ level, 2,4,8 by "       \
+  "default.\n"                                                                 \
+  "* -b <interval>: Time between MLFQ boosts, 100 by default. 0 disables "     \
+  "them.\n"                                                                    \
+  "* -T <latency>: CFS target latency, 24 by default.\n"                       \
+  "* -G <granularity>: CFS minimum granularity, 3 by default.\n"               \
+  "* -H <horizon>: Time periodic tasks stop releasing jobs, a hyperperiod "    \
+  "by default.\n"                                                              \
+  "* -c <cpus>: Simulate this many CPUs with per CPU run queues, 1 by "        \
+  "default. Only fifo, sjf, srt, rr and priority without aging use them.\n"    \
+  "* -M <cost>: Time a process spends migrating to another CPU, 0 by "         \
+  "default.\n"                                                                 \
+  "* -w <cost>: Time a CPU spends switching to another process, 0 by "         \
+  "default.\n"                                                                 \
+  "* -r <refill>: Extra time to refill the cache of a process that was away "  \
+  "for long, 0 by default.\n"                                                  \
+  "* -l <half-life>: Time away that cools half of what's left of the cache, "  \
+  "0 refills it all on every switch.\n"                                        \
+  "* -f <csv|json>: Output format, csv by default.\n"                          \
+  "* -t <dir>: Also write the timeline of each algorithm to "                  \
+  "<dir>/<algorithm>.csv, and the lateness histogram of edf and rm to "        \
+  "<dir>/<algorithm>_lateness.csv.\n"                                          \
+  "* -P <plugin>: Load the scheduling policies of a shared object, they run "  \
+  "after the built-in algorithms on a single CPU and -a takes their names. "   \
+  "Can be repeated.\n"
+
+typedef int SC_CliAlgorithm;
+static const SC_CliAlgorithm SC_CLI_FIFO = 0;
+static const SC_CliAlgorithm SC_CLI_SJF = 1;
+static const SC_CliAlgorithm SC_CLI_SRT = 2;
+static const SC_CliAlgorithm SC_CLI_RR = 3;
+static const SC_CliAlgorithm SC_CLI_PRIORITY = 4;
+static const SC_CliAlgorithm SC_CLI_MLFQ = 5;
+static const SC_CliAlgorithm SC_CLI_CFS = 6;
+static const SC_CliAlgorithm SC_CLI_EDF = 7;
+static const SC_CliAlgorithm SC_CLI_RM = 8;
+static const SC_CliAlgorithm SC_CLI_LOTTERY = 9;
+static const SC_CliAlgorithm SC_CLI_STRIDE = 10;
+static const SC_CliAlgorithm SC_CLI_HRRN = 11;
+#define SC_CLI_ALGORITHM_COUNT 12
+
+// Names used both by the `-a` flag and on the output.
+static const char *SC_CLI_ALGORITHM_NAMES[SC_CLI_ALGORITHM_COUNT] = {
+    "fifo", "sjf", "srt", "rr", "priority", "mlfq", "cfs", "edf", "rm",
+    "lottery", "stride", "hrrn",
+};
+
+typedef enum {
+  SC_CLI_CSV,
+  SC_CLI_JSON,
+} SC_CliFormat;
+
+/**
+ * Everything the command line arguments configure.
+ */
+typedef struct {
+  /** The built-in algorithms and then the policies of the plugins. */
+  SC_Bool enabled[SC_CLI_ALGORITHM_COUNT + SC_MAX_POLICIES];
+  /** The `-a` list, only parsed once every plugin is loaded. */
+  const char *algorithm_list;
+  SC_PolicyRegistry policies;
+  int quantum;
+  uint64_t lottery_seed;
+  SC_Bool preemptive_priority;
+  SC_Time aging_interval;
+  size_t cpu_count;
+  SC_Time migration_cost;
+  SC_SwitchCost switch_cost;
+  SC_MlfqConfig mlfq;
+  SC_CfsConfig cfs;
+  /** When periodic tasks stop releasing jobs, 0 for a hyperperiod. */
+  SC_Time rt_horizon;
+  SC_CliFormat format;
+  /** Directory for the timelines, `NULL` to skip them. */
+  const char *timeline_dir;
+  const char *file_path;
+} SC_CliOptions;
+
+// ################################
+// ||                            ||
+// ||         ARGUMENTS          ||
+// ||                            ||
+// ################################
+
+// Built-in algorithms and plugin policies the CLI can run.
+static size_t algorithm_count(SC_CliOptions *options) {
+  return SC_CLI_ALGORITHM_COUNT + options->policies.count;
+}
+
+// Name of a built-in algorithm or, after them, of a plugin policy.
+static const char *algorithm_name(SC_CliOptions *options, size_t algorithm) {
+  if (algorithm < SC_CLI_ALGORITHM_COUNT) {
+    return SC_CLI_ALGORITHM_NAMES[algorithm];
+  }
+  return options->policies.policies[algorithm - SC_CLI_ALGORITHM_COUNT]->name;
+}
+
+// Enables every algorithm on a comma separated `list`.
+static SC_Bool parse_algorithm_list(const char *list, SC_CliOptions *options) {
+  for (size_t i = 0; i < algorithm_count(options); i++) {
+    options->enabled[i] = SC_FALSE;
+  }
+
+  const char *name = list;
+  while (*name != 0) {
+    size_t length = strcspn(name, ",");
+    SC_Bool found = SC_FALSE;
+    for (size_t i = 0; i < algorithm_count(options); i++) {
+      const char *algorithm = algorithm_name(options, i);
+      if (strlen(algorithm) == length &&
+          memcmp(algorithm, name, length) == 0) {
+        options->enabled[i] = SC_TRUE;
+        found = SC_TRUE;
+      }
+    }
+
+    if (!found) {
+      fprintf(stderr, "ERROR: Unknown algorithm `%.*s`!\n", (int)length, name);
+      return SC_FALSE;
+    }
+
+    name += length;
+    if (*name == ',') {
+      name++;
+    }
+  }
+
+  return SC_TRUE;
+}
+
+// Loads the policies of the plugin at `path`, they can't take the name of a
+// built-in algorithm.
+static SC_Bool load_plugin(const char *path, SC_CliOptions *options) {
+  size_t err = NO_ERROR;
+  size_t count = options->policies.count;
+  SC_PolicyRegistry_Load(&options->policies, path, &err);
+  if (err != NO_ERROR) {
+    fprintf(stderr, "ERROR: %s\n", options->policies.load_error);
+    return SC_FALSE;
+  }
+
+  for (size_t i = count; i < options->policies.count; i++) {
+    const char *name = options->policies.policies[i]->name;
+    for (int j = 0; j < SC_CLI_ALGORITHM_COUNT; j++) {
+      if (strcmp(name, SC_CLI_ALGORITHM_NAMES[j]) == 0) {
+        fprintf(stderr, "ERROR: `%s` is already an algorithm!\n", name);
+        return SC_FALSE;
+      }
+    }
+  }
+
+  return SC_TRUE;
+}
+
+// Returns `SC_FALSE` and prints why if the arguments are invalid.
+static SC_Bool parse_arguments(int argc, char **argv, SC_CliOptions *options) {
+  options->algorithm_list = NULL;
+  SC_PolicyRegistry_Init(&options->policies);
+  options->quantum = 4;
+  options->lottery_seed = 1;
+  options->preemptive_priority = SC_FALSE;
+  options->aging_interval = 0;
+  options->cpu_count = 1;
+  options->migration_cost = 0;
+  options->switch_cost = (SC_SwitchCost){0};
+  options->mlfq = SC_MlfqConfig_Doubling(3, 2, 100);
+  options->cfs = SC_CfsConfig_Default();
+  options->rt_horizon = 0;
+  options->format = SC_CLI_CSV;
+  options->timeline_dir = NULL;
+  options->file_path = NULL;
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    if (strcmp(arg, "-h") == 0) {
+      return SC_FALSE;
+    } else if (strcmp(arg, "-p") == 0) {
+      options->preemptive_priority = SC_TRUE;
+      continue;
+    } else if (arg[0] != '-') {
+      if (NULL != options->file_path) {
+        fprintf(stderr, "ERROR: Only one file can be simulated!\n");
+        return SC_FALSE;
+      }
+      options->file_path = arg;
+      continue;
+    }
+
+    // The rest of the options take a value.
+    if (i + 1 >= argc) {
+      fprintf(stderr, "ERROR: Missing value for `%s`!\n", arg);
+      return SC_FALSE;
+    }
+    const char *value = argv[++i];
+
+    if (strcmp(arg, "-a") == 0) {
+      options->algorithm_list = value;
+    } else if (strcmp(arg, "-P") == 0) {
+      if (!load_plugin(value, options)) {
+        return SC_FALSE;
+      }
+    } else if (strcmp(arg, "-q") == 0) {
+      options->quantum = atoi(value);
+      if (options->quantum <= 0) {
+        fprintf(stderr, "ERROR: The quantum must be greater than 0!\n");
+        return SC_FALSE;
+      }
+    } else if (strcmp(arg, "-s") == 0) {
+      options->lottery_seed = strtoull(value, NULL, 10);
+    } else if (strcmp(arg, "-g") == 0) {
+      options->aging_interval = strtoull(value, NULL, 10);
+    } else if (strcmp(arg, "-L") == 0) {
+      size_t err = NO_ERROR;
+      SC_MlfqConfig_ParseQuanta(&options->mlfq, value, &err);
+      if (err != NO_ERROR) {
+        fprintf(stderr, "ERROR: Invalid MLFQ quanta `%s`!\n", value);
+        return SC_FALSE;
+      }
+    } else if (strcmp(arg, "-b") == 0) {
+      options->mlfq.boost_interval = strtoull(value, NULL, 10);
+    } else if (strcmp(arg, "-T") == 0) {
+      options->cfs.target_latency = strtoull(value, NULL, 10);
+      if (options->cfs.target_latency == 0) {
+        fprintf(stderr, "ERROR: The CFS latency must be greater than 0!\n");
+        return SC_FALSE;
+      }
+    } else if (strcmp(arg, "-G") == 0) {
+      options->cfs.min_granularity = strtoull(value, NULL, 10);
+      if (options->cfs.min_granularity == 0) {
+        fprintf(stderr,
+                "ERROR: The CFS granularity must be greater than 0!\n");
+        return SC_FALSE;
+      }
+    } else if (strcmp(arg, "-H") == 0) {
+      options->rt_horizon = strtoull(value, NULL, 10);
+    } else if (strcmp(arg, "-c") == 0) {
+      options->cpu_count = strtoull(value, NULL, 10);
+      if (options->cpu_count == 0) {
+        fprintf(stderr, "ERROR: There must be at least 1 CPU!\n");
+        return SC_FALSE;
+      }
+    } else if (strcmp(arg, "-M") == 0) {
+      options->migration_cost = strtoull(value, NULL, 10);
+    } else if (strcmp(arg, "-w") == 0) {
+      options->switch_cost.switch_cost = strtoull(value, NULL, 10);
+    } else if (strcmp(arg, "-r") == 0) {
+      options->switch_cost.cache_refill = strtoull(value, NULL, 10);
+    } else if (strcmp(arg, "-l") == 0) {
+      options->switch_cost.cache_half_life = strtoull(value, NULL, 10);
+    } else if (strcmp(arg, "-f") == 0) {
+      if (strcmp(value, "csv") == 0) {
+        options->format = SC_CLI_CSV;
+      } else if (strcmp(value, "json") == 0) {
+        options->format = SC_CLI_JSON;
+      } else {
+        fprintf(stderr, "ERROR: Unknown format `%s`!\n", value);
+        return SC_FALSE;
+      }
+    } else if (strcmp(arg, "-t") == 0) {
+      options->timeline_dir = value;
+    } else {
+      fprintf(stderr, "ERROR: Unknown option `%s`!\n", arg);
+      return SC_FALSE;
+    }
+  }
+
+  if (NULL == options->file_path) {
+    fprintf(stderr, "ERROR: No file supplied!\n");
+    return SC_FALSE;
+  }
+
+  for (size_t i = 0; i < algorithm_count(options); i++) {
+    options->enabled[i] = SC_TRUE;
+  }
+  if (NULL != options->algorithm_list &&
+      !parse_algorithm_list(options->algorithm_list, options)) {
+    return SC_FALSE;
+  }
+
+  return SC_TRUE;
+}
+
+// ################################
+// ||                            ||
+// ||           OUTPUT           ||
+// ||                            ||
+// ################################
+
+static void print_metrics_header(SC_CliFormat format) {
+  if (format == SC_CLI_JSON) {
+    printf("[");
+    return;
+  }
+
+  printf("algorithm,avg_waiting_time,waiting_p50,waiting_p90,waiting_p99,"
+         "waiting_max,avg_turnaround_time,avg_response_time,throughput,"
+         "cpu_utilization,context_switches,makespan,migrations,"
+         "load_imbalance,jobs,deadline_misses,lateness_p99,lateness_max,"
+         "fairness,avg_io_waiting_time,cpu_efficiency\n");
+}
+
+static void print_metrics(SC_CliFormat format, const char *algorithm,
+                          SC_Simulation *sim, SC_Bool first) {
+  if (format == SC_CLI_JSON) {
+    printf("%s\n  {\"algorithm\": \"%s\", \"avg_waiting_time\": %.4f, "
+           "\"waiting_p50\": %" PRIu64 ", \"waiting_p90\": %" PRIu64
+           ", \"waiting_p99\": %" PRIu64 ", \"waiting_max\": %" PRIu64
+           ", \"avg_turnaround_time\": %.4f, \"avg_response_time\": %.4f, "
+           "\"throughput\": %.6f, \"cpu_utilization\": %.6f, "
+           "\"context_switches\": %zu, \"makespan\": %" PRIu64
+           ", \"migrations\": %zu, \"load_imbalance\": %.6f, "
+           "\"jobs\": %zu, \"deadline_misses\": %zu, "
+           "\"lateness_p99\": %" PRIu64 ", \"lateness_max\": %" PRIu64
+           ", \"fairness\": %.6f, \"avg_io_waiting_time\": %.4f, "
+           "\"cpu_efficiency\": %.6f}",
+           first ? "" : ",", algorithm, sim->avg_waiting_time,
+           sim->waiting_p50, sim->waiting_p90, sim->waiting_p99,
+           sim->waiting_max, sim->avg_turnaround_time, sim->avg_response_time,
+           sim->throughput, sim->cpu_utilization, sim->context_switches,
+           sim->makespan, sim->migrations, sim->load_imbalance, sim->jobs,
+           sim->deadline_misses, sim->lateness_p99, sim->lateness_max,
+           sim->fairness, sim->avg_io_waiting_time, sim->cpu_efficiency);
+    return;
+  }
+
+  printf("%s,%.4f,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64
+         ",%.4f,%.4f,%.6f,%.6f,%zu,%" PRIu64 ",%zu,%.6f,%zu,%zu,%" PRIu64
+         ",%" PRIu64 ",%.6f,%.4f,%.6f\n",
+         algorithm, sim->avg_waiting_time, sim->waiting_p50, sim->waiting_p90,
+         sim->waiting_p99, sim->waiting_max, sim->avg_turnaround_time,
+         sim->avg_response_time, sim->throughput, sim->cpu_utilization,
+         sim->context_switches, sim->makespan, sim->migrations,
+         sim->load_imbalance, sim->jobs, sim->deadline_misses,
+         sim->lateness_p99, sim->lateness_max, sim->fairness,
+         sim->avg_io_waiting_time, sim->cpu_efficiency);
+}
+
+static void print_metrics_footer(SC_CliFormat format) {
+  if (format == SC_CLI_JSON) {
+    printf("\n]\n");
+  }
+}
+
+// Writes the timeline of `sim` to `<dir>/<algorithm>.csv`.
+static void write_timeline(const char *dir, const char *algorithm,
+                           SC_Simulation *sim, SC_StringList *pid_list,
+                           SC_Err err) {
+  char path[4096];
+  snprintf(path, sizeof(path), "%s/%s.csv", dir, algorithm);
+
+  FILE *out = fopen(path, "w");
+  if (NULL == out) {
+    fprintf(stderr, "ERROR: Can't write the timeline at `%s`!\n", path);
+    *err = RESOURCE_NOT_FOUND;
+    return;
+  }
+
+  SC_Simulation_ExportTimeline(sim, pid_list, out, err);
+  fclose(out);
+}
+
+// Writes the lateness histogram to `<dir>/<algorithm>_lateness.csv`.
+static void write_lateness(const char *dir, const char *algorithm,
+                           SC_Histogram *lateness, SC_Err err) {
+  char path[4096];
+  snprintf(path, sizeof(path), "%s/%s_lateness.csv", dir, algorithm);
+
+  FILE *out = fopen(path, "w");
+  if (NULL == out) {
+    fprintf(stderr, "ERROR: Can't write the lateness at `%s`!\n", path);
+    *err = RESOURCE_NOT_FOUND;
+    return;
+  }
+
+  SC_Histogram_Export(lateness, out);
+  fclose(out);
+}
+
+// Tells on stderr if the periodic tasks are known to meet their deadlines.
+static void print_schedulability(SC_ProcessTable *processes) {
+  SC_RtSchedulability schedulability = SC_Rt_CheckSchedulability(processes);
+  if (schedulability.task_count == 0) {
+    return;
+  }
+
+  fprintf(stderr,
+          "INFO: %zu periodic tasks, utilization %.4f, density %.4f, RM "
+          "bound %.4f. EDF %s and RM %s meet every deadline.\n",
+          schedulability.task_count, schedulability.utilization,
+          schedulability.density, schedulability.rate_monotonic_bound,
+          schedulability.edf_schedulable ? "will" : "may not",
+          schedulability.rate_monotonic_schedulable ? "will" : "may not");
+}
+
+// ################################
+// ||                            ||
+// ||            MAIN            ||
+// ||                            ||
+// ################################
+
+/**
+ * Reads the whole file at `path`, ending it with a new line if it doesn't.
+ *
+ * Returns an empty string with a `NULL` data if it can't be read.
+ */
+static SC_String read_file(const char *path) {
+  SC_String contents = {0};
+  FILE *file = fopen(path, "rb");
+  if (NULL == file) {
+    return contents;
+  }
+
+  fseek(file, 0, SEEK_END);
+  long length = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  if (length < 0) {
+    fclose(file);
+    return contents;
+  }
+
+  contents.data = malloc(length + 1);
+  if (NULL == contents.data) {
+    fclose(file);
+    return contents;
+  }
+
+  contents.length = fread(contents.data, 1, length, file);
+  fclose(file);
+  // The parser only accepts a process once it finds its new line.
+  if (contents.length > 0 && contents.data[contents.length - 1] != '\n') {
+    contents.data[contents.length++] = '\n';
+  }
+  contents.data_capacity = length + 1;
+
+  return contents;
+}
+
+// The policy `simulate_smp` uses to run `algorithm`.
+static SC_SmpPolicy smp_policy(SC_CliAlgorithm algorithm,
+                               SC_CliOptions *options) {
+  if (algorithm == SC_CLI_SJF) {
+    return SC_SMP_SHORTEST_FIRST;
+  } else if (algorithm == SC_CLI_SRT) {
+    return SC_SMP_SHORTEST_REMAINING;
+  } else if (algorithm == SC_CLI_RR) {
+    return SC_SMP_ROUND_ROBIN;
+  } else if (algorithm == SC_CLI_PRIORITY) {
+    return options->preemptive_priority ? SC_SMP_PRIORITY_PREEMPTIVE
+                                        : SC_SMP_PRIORITY;
+  }
+  return SC_SMP_FIFO;
+}
+
+/**
+ * Runs `algorithm` on `sim`. The real-time ones also fill `lateness`.
+ */
+static void run_algorithm(SC_CliAlgorithm algorithm, SC_CliOptions *options,
+                          SC_ProcessTable *processes, SC_Simulation *sim,
+                          SC_Histogram *lateness, SC_Err err) {
+  if (algorithm >= SC_CLI_ALGORITHM_COUNT) {
+    const SC_Policy *policy =
+        options->policies.policies[algorithm - SC_CLI_ALGORITHM_COUNT];
+    simulate_policy(processes, sim, policy, err);
+  } else if (algorithm == SC_CLI_EDF || algorithm == SC_CLI_RM) {
+    SC_RtConfig config = SC_RtConfig_Default(
+        algorithm == SC_CLI_EDF ? SC_RT_EARLIEST_DEADLINE
+                                : SC_RT_RATE_MONOTONIC,
+        processes);
+    if (options->rt_horizon > 0) {
+      config.horizon = options->rt_horizon;
+    }
+    config.lateness = lateness;
+    simulate_real_time(processes, sim, &config, err);
+  } else if (algorithm == SC_CLI_MLFQ) {
+    simulate_multilevel_feedback(processes, sim, &options->mlfq, err);
+  } else if (algorithm == SC_CLI_CFS) {
+    simulate_completely_fair(processes, sim, &options->cfs, err);
+  } else if (algorithm == SC_CLI_LOTTERY) {
+    simulate_lottery(processes, sim, options->quantum, options->lottery_seed,
+                     err);
+  } else if (algorithm == SC_CLI_STRIDE) {
+    simulate_stride(processes, sim, options->quantum, err);
+  } else if (algorithm == SC_CLI_HRRN) {
+    simulate_highest_response_ratio(processes, sim, err);
+  } else if (options->cpu_count > 1 || SC_ProcessTable_HasIo(processes)) {
+    SC_SmpConfig config = {
+        .policy = smp_policy(algorithm, options),
+        .cpu_count = options->cpu_count,
+        .quantum = options->quantum,
+        .migration_cost = options->migration_cost,
+    };
+    simulate_smp(processes, sim, &config, err);
+  } else if (algorithm == SC_CLI_FIFO) {
+    simulate_first_in_first_out(processes, sim, err);
+  } else if (algorithm == SC_CLI_SJF) {
+    simulate_shortest_first(processes, sim, err);
+  } else if (algorithm == SC_CLI_SRT) {
+    simulate_shortest_remaining(processes, sim, err);
+  } else if (algorithm == SC_CLI_RR) {
+    simulate_round_robin(processes, sim, options->quantum, err);
+  } else if (algorithm == SC_CLI_PRIORITY && options->preemptive_priority) {
+    simulate_priority_preemptive(processes, sim, options->aging_interval, err);
+  } else if (algorithm == SC_CLI_PRIORITY) {
+    simulate_priority(processes, sim, err);
+  }
+}
+
+int main(int argc, char **argv) {
+  SC_CliOptions options = {0};
+  if (!parse_arguments(argc, argv, &options)) {
+    fprintf(stderr, HELP);
+    return 1;
+  }
+
+  SC_String file_contents = read_file(options.file_path);
+  if (NULL == file_contents.data) {
+    fprintf(stderr, "ERROR: Failed to read `%s`!\n", options.file_path);
+    return 1;
+  }
+
+  size_t err = NO_ERROR;
+  struct SC_Arena pids_arena = {0};
+  SC_Arena_Init(&pids_arena, 1024, &err);
+  if (err != NO_ERROR) {
+    fprintf(stderr, "ERROR: %s\n", SC_Err_ToString(&err));
+    return 1;
+  }
+
+  SC_StringList pid_list = {0};
+  SC_StringList_Init(&pid_list);
+
+  SC_ProcessTable processes = {0};
+  SC_ProcessTable_Init(&processes, 64, &err);
+  if (err != NO_ERROR) {
+    fprintf(stderr, "ERROR: %s\n", SC_Err_ToString(&err));
+    return 1;
+  }
+
+  parse_scheduling_file(&file_contents, &pids_arena, &pid_list, &processes,
+                        &err);
+  free(file_contents.data);
+  if (err != NO_ERROR) {
+    fprintf(stderr, "ERROR: %s\n", SC_Err_ToString(&err));
+    return 1;
+  }
+
+  // Steps are never rendered, the timeline is only kept to export it.
+  SC_RecordMode record_mode =
+      NULL == options.timeline_dir ? SC_RECORD_METRICS : SC_RECORD_STEPS;
+
+  print_schedulability(&processes);
+
+  SC_Bool first = SC_TRUE;
+  print_metrics_header(options.format);
+  for (size_t i = 0; i < algorithm_count(&options); i++) {
+    if (!options.enabled[i]) {
+      continue;
+    }
+
+    SC_Simulation sim = {
+        .record_mode = record_mode,
+        .switch_cost = options.switch_cost,
+    };
+    SC_Histogram lateness = {0};
+    run_algorithm(i, &options, &processes, &sim, &lateness, &err);
+    if (err == NO_ERROR && NULL != options.timeline_dir) {
+      write_timeline(options.timeline_dir, algorithm_name(&options, i), &sim,
+                     &pid_list, &err);
+    }
+    if (err == NO_ERROR && NULL != options.timeline_dir &&
+        (i == SC_CLI_EDF || i == SC_CLI_RM)) {
+      write_lateness(options.timeline_dir, SC_CLI_ALGORITHM_NAMES[i],
+                     &lateness, &err);
+    }
+    if (err != NO_ERROR) {
+      fprintf(stderr, "ERROR: %s\n", SC_Err_ToString(&err));
+      SC_Simulation_Deinit(&sim);
+      return 1;
+    }
+
+    print_metrics(options.format, algorithm_name(&options, i), &sim, first);
+    first = SC_FALSE;
+    SC_Simulation_Deinit(&sim);
+  }
+  print_metrics_footer(options.format);
+
+  SC_ProcessTable_Deinit(&processes);
+  SC_Arena_Deinit(&pids_arena);
+  SC_PolicyRegistry_Deinit(&options.policies);
+  return 0;
+}
@@ -0,0 +1,291 @@
+#include "lib.c"
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ################################
+// ||                            ||
+// ||         CONSTANTS          ||
+// ||                            ||
+// ################################
+
+#define HELP                                                                   \
+  "Usage: generate [options]\n"                                                \
+  "Writes a synthetic scheduling file, or the three files of a "               \
+  "synchronization simulation with -y.\n"                                      \
+  "\n"                                                                         \
+  "Options:\n"                                                                 \
+  "* -n <count>: Processes to generate, 1000 by default.\n"                    \
+  "* -s <seed>: Seed of the generator, 1 by default.\n"                        \
+  "* -o <file>: Where to write the scheduling file, stdout by default.\n"      \
+  "\n"                                                                         \
+  "Arrivals:\n"                                                                \
+  "* -a <poisson|bursty>: Arrival distribution, poisson by default.\n"         \
+  "* -i <mean>: Mean time between arrivals, 10 by default.\n"                  \
+  "* -G <mean>: Bursty: mean processes per group, 20 by default.\n"            \
+  "* -Q <mean>: Bursty: mean quiet time between groups, 200 by default.\n"     \
+  "\n"                                                                         \
+  "Bursts:\n"                                                                  \
+  "* -b <exponential|pareto|bimodal>: Burst distribution, exponential by "     \
+  "default.\n"                                                                 \
+  "* -B <mean>: Mean burst time, of the short ones if bimodal. 8 by "          \
+  "default.\n"                                                                 \
+  "* -k <alpha>: Pareto: shape of the tail, over 1. 1.5 by default.\n"         \
+  "* -l <mean>: Bimodal: mean burst time of the long ones, 80 by default.\n"   \
+  "* -p <fraction>: Bimodal: fraction of long processes, 0.1 by default.\n"    \
+  "* -P <max>: Highest priority, 9 by default.\n"                              \
+  "\n"                                                                         \
+  "Synchronization:\n"                                                         \
+  "* -y <dir>: Write <dir>/sync_process.txt, <dir>/sync_resources.txt and "    \
+  "<dir>/sync_actions.txt instead.\n"                                          \
+  "* -r <count>: Resources, 4 by default.\n"                                   \
+  "* -x <count>: Actions per process, 2 by default.\n"
+
+// Big buffers so tens of millions of rows are written in few system calls.
+static const size_t SC_GENERATE_BUFFER_SIZE = 1 << 20;
+
+// ################################
+// ||                            ||
+// ||         ARGUMENTS          ||
+// ||                            ||
+// ################################
+
+/**
+ * Everything the command line arguments configure.
+ */
+typedef struct {
+  SC_WorkloadConfig config;
+  size_t count;
+  uint64_t seed;
+  /** Scheduling file, `NULL` for stdout. */
+  const char *output;
+  /** Directory for the synchronization files, `NULL` to skip them. */
+  const char *sync_dir;
+  size_t resource_count;
+  size_t actions_per_process;
+} SC_GenerateOptions;
+
+// Returns `SC_FALSE` if `value` isn't a positive number.
+static SC_Bool parse_positive(const char *value, double *out) {
+  char *end = NULL;
+  double parsed = strtod(value, &end);
+  if (end == value || *end != 0 || !(parsed > 0)) {
+    fprintf(stderr, "ERROR: `%s` isn't a positive number!\n", value);
+    return SC_FALSE;
+  }
+  *out = parsed;
+  return SC_TRUE;
+}
+
+// Returns `SC_FALSE` if `value` isn't a whole number.
+static SC_Bool parse_whole(const char *value, uint64_t *out) {
+  char *end = NULL;
+  errno = 0;
+  uint64_t parsed = strtoull(value, &end, 10);
+  // `strtoull` also takes a sign or leading spaces.
+  if (!isdigit((unsigned char)value[0]) || *end != 0 || errno == ERANGE) {
+    fprintf(stderr, "ERROR: `%s` isn't a whole number!\n", value);
+    return SC_FALSE;
+  }
+  *out = parsed;
+  return SC_TRUE;
+}
+
+// Returns `SC_FALSE` if `value` isn't a number from 0 to 1.
+static SC_Bool parse_fraction(const char *value, double *out) {
+  char *end = NULL;
+  double parsed = strtod(value, &end);
+  if (end == value || *end != 0 || !(parsed >= 0 && parsed <= 1)) {
+    fprintf(stderr, "ERROR: `%s` isn't a number from 0 to 1!\n", value);
+    return SC_FALSE;
+  }
+  *out = parsed;
+  return SC_TRUE;
+}
+
+// Returns `SC_FALSE` and prints why if the arguments are invalid.
+static SC_Bool parse_arguments(int argc, char **argv,
+                               SC_GenerateOptions *options) {
+  options->config = SC_WorkloadConfig_Default();
+  options->count = 1000;
+  options->seed = 1;
+  options->output = NULL;
+  options->sync_dir = NULL;
+  options->resource_count = 4;
+  options->actions_per_process = 2;
+
+  SC_WorkloadConfig *config = &options->config;
+  uint64_t whole = 0;
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    if (strcmp(arg, "-h") == 0) {
+      return SC_FALSE;
+    }
+
+    // Every other option takes a value.
+    if (i + 1 >= argc) {
+      fprintf(stderr, "ERROR: Missing value for `%s`!\n", arg);
+      return SC_FALSE;
+    }
+    const char *value = argv[++i];
+
+    SC_Bool valid = SC_TRUE;
+    if (strcmp(arg, "-n") == 0) {
+      valid = parse_whole(value, &whole);
+      options->count = whole;
+    } else if (strcmp(arg, "-s") == 0) {
+      valid = parse_whole(value, &options->seed);
+    } else if (strcmp(arg, "-o") == 0) {
+      options->output = value;
+    } else if (strcmp(arg, "-a") == 0) {
+      if (strcmp(value, "poisson") == 0) {
+        config->arrivals = SC_ARRIVALS_POISSON;
+      } else if (strcmp(value, "bursty") == 0) {
+        config->arrivals = SC_ARRIVALS_BURSTY;
+      } else {
+        fprintf(stderr, "ERROR: Unknown arrival distribution `%s`!\n", value);
+        valid = SC_FALSE;
+      }
+    } else if (strcmp(arg, "-i") == 0) {
+      valid = parse_positive(value, &config->mean_interarrival);
+    } else if (strcmp(arg, "-G") == 0) {
+      valid = parse_positive(value, &config->mean_group_size);
+    } else if (strcmp(arg, "-Q") == 0) {
+      valid = parse_positive(value, &config->mean_quiet_time);
+    } else if (strcmp(arg, "-b") == 0) {
+      if (strcmp(value, "exponential") == 0) {
+        config->bursts = SC_BURSTS_EXPONENTIAL;
+      } else if (strcmp(value, "pareto") == 0) {
+        config->bursts = SC_BURSTS_PARETO;
+      } else if (strcmp(value, "bimodal") == 0) {
+        config->bursts = SC_BURSTS_BIMODAL;
+      } else {
+        fprintf(stderr, "ERROR: Unknown burst distribution `%s`!\n", value);
+        valid = SC_FALSE;
+      }
+    } else if (strcmp(arg, "-B") == 0) {
+      valid = parse_positive(value, &config->mean_burst);
+    } else if (strcmp(arg, "-k") == 0) {
+      valid = parse_positive(value, &config->pareto_alpha) &&
+              config->pareto_alpha > 1;
+    } else if (strcmp(arg, "-l") == 0) {
+      valid = parse_positive(value, &config->mean_long_burst);
+    } else if (strcmp(arg, "-p") == 0) {
+      valid = parse_fraction(value, &config->long_fraction);
+    } else if (strcmp(arg, "-P") == 0) {
+      valid = parse_whole(value, &whole);
+      // Priorities are drawn modulo `max_priority + 1`, it can't wrap to 0.
+      if (valid && whole >= UINT_MAX) {
+        fprintf(stderr, "ERROR: The highest priority must be under %u!\n",
+                UINT_MAX);
+        valid = SC_FALSE;
+      }
+      config->max_priority = whole;
+    } else if (strcmp(arg, "-y") == 0) {
+      options->sync_dir = value;
+    } else if (strcmp(arg, "-r") == 0) {
+      valid = parse_whole(value, &whole);
+      options->resource_count = whole;
+    } else if (strcmp(arg, "-x") == 0) {
+      valid = parse_whole(value, &whole);
+      options->actions_per_process = whole;
+    } else {
+      fprintf(stderr, "ERROR: Unknown option `%s`!\n", arg);
+      valid = SC_FALSE;
+    }
+
+    if (!valid) {
+      return SC_FALSE;
+    }
+  }
+
+  return SC_TRUE;
+}
+
+// ################################
+// ||                            ||
+// ||            MAIN            ||
+// ||                            ||
+// ################################
+
+// Opens `<dir>/<name>` for writing with a big buffer, or prints why it can't.
+static FILE *open_output(const char *dir, const char *name) {
+  char path[4096];
+  snprintf(path, sizeof(path), "%s/%s", dir, name);
+
+  FILE *file = fopen(path, "w");
+  if (NULL == file) {
+    fprintf(stderr, "ERROR: Can't write `%s`!\n", path);
+    return NULL;
+  }
+  setvbuf(file, NULL, _IOFBF, SC_GENERATE_BUFFER_SIZE);
+  return file;
+}
+
+static void write_sync_files(SC_GenerateOptions *options, SC_Workload *workload,
+                             SC_Err err) {
+  FILE *processes = open_output(options->sync_dir, "sync_process.txt");
+  FILE *resources = open_output(options->sync_dir, "sync_resources.txt");
+  FILE *actions = open_output(options->sync_dir, "sync_actions.txt");
+
+  if (NULL != processes && NULL != resources && NULL != actions) {
+    SC_Workload_WriteSync(workload, options->count, options->resource_count,
+                          options->actions_per_process, processes, resources,
+                          actions, err);
+  } else {
+    *err = FILE_WRITE_FAILED;
+  }
+
+  FILE *files[] = {processes, resources, actions};
+  for (int i = 0; i < 3; i++) {
+    if (NULL != files[i] && fclose(files[i]) != 0) {
+      *err = FILE_WRITE_FAILED;
+    }
+  }
+}
+
+static void write_scheduling_file(SC_GenerateOptions *options,
+                                  SC_Workload *workload, SC_Err err) {
+  FILE *out = stdout;
+  if (NULL != options->output) {
+    out = fopen(options->output, "w");
+    if (NULL == out) {
+      fprintf(stderr, "ERROR: Can't write `%s`!\n", options->output);
+      *err = FILE_WRITE_FAILED;
+      return;
+    }
+  }
+  setvbuf(out, NULL, _IOFBF, SC_GENERATE_BUFFER_SIZE);
+
+  SC_Workload_WriteScheduling(workload, options->count, out, err);
+  if (fflush(out) != 0 || (out != stdout && fclose(out) != 0)) {
+    *err = FILE_WRITE_FAILED;
+  }
+}
+
+int main(int argc, char **argv) {
+  SC_GenerateOptions options = {0};
+  if (!parse_arguments(argc, argv, &options)) {
+    fprintf(stderr, HELP);
+    return 1;
+  }
+
+  SC_Workload workload = {0};
+  SC_Workload_Init(&workload, options.config, options.seed);
+
+  size_t err = NO_ERROR;
+  if (NULL != options.sync_dir) {
+    write_sync_files(&options, &workload, &err);
+  } else {
+    write_scheduling_file(&options, &workload, &err);
+  }
+
+  if (err != NO_ERROR) {
+    fprintf(stderr, "ERROR: %s\n", SC_Err_ToString(&err));
+    return 1;
+  }
+  return 0;
+}
@@ -1,17 +1,32 @@
 #include "sys/types.h"
+#include <dlfcn.h>
+#include <inttypes.h>
+#include <math.h>
 #include <stdarg.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+// The types shared with scheduling policy plugins.
+#include "policy.h"
+
 // ################################
 // ||                            ||
 // ||          UTILITIES         ||
 // ||                            ||
 // ################################
 
+// Functions the hot loops are specialised with at compile time. They're
+// inlined even without optimizations, so their constant arguments fold away.
+#define SC_ALWAYS_INLINE static inline __attribute__((always_inline))
+
 static int SC_Min(int a, int b) { return a < b ? a : b; }
 
+static SC_Time SC_Time_Max(SC_Time a, SC_Time b) { return a > b ? a : b; }
+
+static SC_Time SC_Time_Min(SC_Time a, SC_Time b) { return a < b ? a : b; }
+
 // ################################
 // ||                            ||
 // ||           ERRORS           ||
@@ -19,19 +34,8 @@ static int SC_Min(int a, int b) { return a < b ? a : b; }
 // ################################
 
 typedef unsigned int uint;
-typedef size_t *SC_Err;
-static const size_t NO_ERROR = 1;
-static const size_t NOT_FOUND = 2;
-static const size_t MALLOC_FAILED = 3;
-static const size_t ARENA_ALLOC_NO_SPACE = 4;
-static const size_t OUT_OF_BOUNDS = 5;
-static const size_t EMPTY_STRING = 6;
-static const size_t INVALID_STRING = 7;
-static const size_t INVALID_TXT_FILE = 8;
-static const size_t RESOURCE_NOT_FOUND = 9;
-static const size_t PROCESS_NOT_FOUND = 10;
-static const size_t SLICE_EXPANSION_FAILED = 11;
 
+// `SC_Err` and its values live on `policy.h`, plugins report errors too.
 static const char *SC_Err_ToString(SC_Err err) {
   size_t val = *err;
   if (val == NO_ERROR) {
@@ -56,15 +60,17 @@ static const char *SC_Err_ToString(SC_Err err) {
     return "Process not found!";
   } else if (val == SLICE_EXPANSION_FAILED) {
     return "Slice expansion failed!";
+  } else if (val == FILE_WRITE_FAILED) {
+    return "Failed to write the file!";
+  } else if (val == INVALID_POLICY) {
+    return "The scheduling policy is incomplete or its name is taken!";
+  } else if (val == POLICY_LOAD_FAILED) {
+    return "Failed to load the scheduling policy plugin!";
   } else {
     return "INVALID ERROR VALUE RECEIVED!";
   }
 }
 
-typedef int SC_Bool;
-static const SC_Bool SC_TRUE = 1;
-static const SC_Bool SC_FALSE = 0;
-
 // A panic represents an irrecoverable error.
 //
 // The program somehow got into an irrecoverable state and there's no other
@@ -164,13 +170,14 @@ void *SC_Arena_Alloc(struct SC_Arena *arena, size_t requested_size,
   } else if (NULL != arena->next) {
     return SC_Arena_Alloc(arena->next, requested_size, err);
   } else {
-    size_t next_capacity = arena->capacity;
+    // Children double in size, so the chain stays short for big inputs.
+    size_t next_capacity = arena->capacity * 2;
     if (next_capacity < requested_size) {
       next_capacity = requested_size;
     }
 
     arena->next = malloc(sizeof(struct SC_Arena));
-    if (NULL == arena) {
+    if (NULL == arena->next) {
       *err = MALLOC_FAILED;
       return NULL;
     }
@@ -320,6 +327,38 @@ int SC_String_ParseInt(SC_String *str, SC_Err err) {
   return result;
 }
 
+/**
+ * Tries to parse a SC_String into an `SC_Time`.
+ *
+ * Works like `SC_String_ParseInt` but the value can't be negative and it can
+ * hold up to 64 bits. INVALID_STRING is set on the err if the value doesn't
+ * fit.
+ */
+SC_Time SC_String_ParseTime(SC_String *str, SC_Err err) {
+  if (str->length <= 0) {
+    *err = EMPTY_STRING;
+    return 0;
+  }
+
+  SC_Time result = 0;
+  for (size_t i = 0; i < str->length; i++) {
+    char digit = SC_String_CharAt(str, i);
+    if (digit < '0' || digit > '9') {
+      *err = INVALID_STRING;
+      return 0;
+    }
+
+    SC_Time value = digit - '0';
+    if (result > (SC_TIME_MAX - value) / 10) {
+      *err = INVALID_STRING;
+      return 0;
+    }
+    result = result * 10 + value;
+  }
+
+  return result;
+}
+
 /**
  * Removes all characters that match search from the start of the string.
  */
@@ -571,621 +610,5691 @@ void SC_Slice_deinit(SC_Slice *s) {
   s->element_size = 0;
 }
 
-// ##################################
-// #                                #
-// #       CALENDARIZER             #
-// #                                #
-// ##################################
+// ===========
+//  HEAPS
+// ===========
 
+/**
+ * An element of an `SC_Heap`.
+ *
+ * Entries are ordered by `key` and ties are broken by the lowest `idx`.
+ */
 typedef struct {
-  size_t pid_idx;
-  uint burst_time;
-  uint arrival_time;
-  uint waiting_time;
-  uint priority;
-} SC_Process;
-
-typedef struct SC_ProcessList_Node {
-  SC_Process value;
-  struct SC_ProcessList_Node *next;
-} SC_ProcessList_Node;
+  SC_Time key;
+  size_t idx;
+} SC_HeapEntry;
 
+/**
+ * A binary min-heap of `SC_HeapEntry`.
+ *
+ * Push and pop cost O(log n), peeking the minimum costs O(1).
+ */
 typedef struct {
-  size_t count;
-  struct SC_ProcessList_Node *head;
-  struct SC_ProcessList_Node *tail;
-} SC_ProcessList;
-
-void SC_ProcessList_sort(SC_ProcessList *list,
-                         int (*cmp)(SC_Process, SC_Process));
-int compare_by_arrival_time(SC_Process a, SC_Process b);
-int compare_by_burst_time(SC_Process a, SC_Process b);
-int compare_by_priority(SC_Process a, SC_Process b);
-int SC_Total_busrt_time(SC_ProcessList *list);
-int compare_proc_ptrAT(const void *a, const void *b);
-int compare_proc_ptrBT(const void *a, const void *b);
-int compare_proc_ptrP(const void *a, const void *b);
-
-void SC_ProcessList_Init(SC_ProcessList *list) {
-  list->count = 0;
-  list->head = NULL;
-  list->tail = NULL;
+  SC_HeapEntry *data;
+  size_t length;
+  size_t capacity;
+} SC_Heap;
+
+static SC_Bool SC_HeapEntry_Less(SC_HeapEntry a, SC_HeapEntry b) {
+  if (a.key != b.key) {
+    return a.key < b.key;
+  }
+  return a.idx < b.idx;
 }
 
-void SC_ProcessList_Reset(SC_ProcessList *list) {
-  list->count = 0;
-  list->head = NULL;
-  list->tail = NULL;
+// Sorts `SC_HeapEntry` with `qsort` in the same order the heaps use.
+static int SC_HeapEntry_Compare(const void *a, const void *b) {
+  const SC_HeapEntry *entry_a = a;
+  const SC_HeapEntry *entry_b = b;
+  return SC_HeapEntry_Less(*entry_b, *entry_a) -
+         SC_HeapEntry_Less(*entry_a, *entry_b);
 }
 
-void SC_ProcessList_Append(SC_ProcessList *list, struct SC_Arena *arena,
-                           SC_Process process, SC_Err err) {
-  struct SC_ProcessList_Node *node =
-      SC_Arena_Alloc(arena, sizeof(struct SC_ProcessList_Node), err);
-  if (*err != NO_ERROR) {
+// Below this many entries, insertion sort beats the passes of a radix sort.
+static const size_t SC_HEAP_ENTRY_SORT_CUTOFF = 64;
+
+/**
+ * Sorts `entries` in the order the heaps use, without calling a comparator.
+ *
+ * It's a radix sort on the key that skips the bytes every key shares, so
+ * times that fit in 3 bytes take 3 passes. It's stable, so ties end up
+ * ordered by `idx` as long as the entries come ordered by it, like the ones
+ * built from a table. Tables usually list processes in the order they
+ * arrive, so entries that are already sorted only take one pass to check.
+ * It falls back to `qsort` if there's no memory for the scratch buffer.
+ */
+void SC_HeapEntry_Sort(SC_HeapEntry *entries, size_t n) {
+  size_t sorted = 1;
+  while (sorted < n && entries[sorted - 1].key <= entries[sorted].key) {
+    sorted++;
+  }
+  if (sorted >= n) {
     return;
   }
 
-  node->value = process;
-  node->next = NULL;
+  if (n < SC_HEAP_ENTRY_SORT_CUTOFF) {
+    for (size_t i = 1; i < n; i++) {
+      SC_HeapEntry entry = entries[i];
+      size_t j = i;
+      for (; j > 0 && SC_HeapEntry_Less(entry, entries[j - 1]); j--) {
+        entries[j] = entries[j - 1];
+      }
+      entries[j] = entry;
+    }
+    return;
+  }
 
-  if (list->count == 0) {
-    list->head = node;
-    list->tail = node;
-  } else if (list->count == 1) {
-    list->head->next = node;
-    list->tail = node;
-  } else {
-    list->tail->next = node;
-    list->tail = node;
+  SC_HeapEntry *scratch = malloc(sizeof(SC_HeapEntry) * n);
+  if (NULL == scratch) {
+    qsort(entries, n, sizeof(SC_HeapEntry), SC_HeapEntry_Compare);
+    return;
   }
 
-  list->count++;
+  size_t counts[sizeof(SC_Time)][256] = {0};
+  for (size_t i = 0; i < n; i++) {
+    SC_Time key = entries[i].key;
+    for (size_t byte = 0; byte < sizeof(SC_Time); byte++) {
+      counts[byte][(key >> (8 * byte)) & 0xff]++;
+    }
+  }
+
+  SC_HeapEntry *from = entries;
+  SC_HeapEntry *to = scratch;
+  for (size_t byte = 0; byte < sizeof(SC_Time); byte++) {
+    size_t *count = counts[byte];
+    int shift = 8 * byte;
+    if (count[(from[0].key >> shift) & 0xff] == n) {
+      continue;
+    }
+
+    size_t offset = 0;
+    for (int digit = 0; digit < 256; digit++) {
+      size_t digit_count = count[digit];
+      count[digit] = offset;
+      offset += digit_count;
+    }
+    for (size_t i = 0; i < n; i++) {
+      to[count[(from[i].key >> shift) & 0xff]++] = from[i];
+    }
+
+    SC_HeapEntry *swap = from;
+    from = to;
+    to = swap;
+  }
+
+  if (from != entries) {
+    memcpy(entries, from, sizeof(SC_HeapEntry) * n);
+  }
+  free(scratch);
 }
 
-SC_Process SC_ProcessList_GetAt(SC_ProcessList *list, size_t idx, SC_Err err) {
-  SC_Process sb = {};
+void SC_Heap_Init(SC_Heap *heap, size_t initial_capacity, SC_Err err) {
+  if (initial_capacity == 0) {
+    initial_capacity = 1;
+  }
 
-  struct SC_ProcessList_Node *current = list->head;
-  for (int i = 0; current != NULL && i < idx; i++) {
-    current = current->next;
+  heap->data = malloc(sizeof(SC_HeapEntry) * initial_capacity);
+  if (NULL == heap->data) {
+    *err = MALLOC_FAILED;
+    return;
   }
+  heap->length = 0;
+  heap->capacity = initial_capacity;
+}
 
-  if (current == NULL) {
-    *err = NOT_FOUND;
-  } else {
-    sb = current->value;
+void SC_Heap_Deinit(SC_Heap *heap) {
+  free(heap->data);
+  heap->data = NULL;
+  heap->length = 0;
+  heap->capacity = 0;
+}
+
+void SC_Heap_Push(SC_Heap *heap, SC_HeapEntry entry, SC_Err err) {
+  if (heap->length == heap->capacity) {
+    size_t new_capacity = heap->capacity * 2;
+    SC_HeapEntry *new_data =
+        realloc(heap->data, sizeof(SC_HeapEntry) * new_capacity);
+    if (NULL == new_data) {
+      *err = SLICE_EXPANSION_FAILED;
+      return;
+    }
+    heap->data = new_data;
+    heap->capacity = new_capacity;
   }
 
-  return sb;
+  size_t i = heap->length++;
+  while (i > 0) {
+    size_t parent = (i - 1) / 2;
+    if (!SC_HeapEntry_Less(entry, heap->data[parent])) {
+      break;
+    }
+    heap->data[i] = heap->data[parent];
+    i = parent;
+  }
+  heap->data[i] = entry;
+}
+
+SC_HeapEntry SC_Heap_Peek(SC_Heap *heap) {
+  if (heap->length == 0) {
+    SC_PANIC("Trying to peek an empty heap!");
+  }
+  return heap->data[0];
+}
+
+SC_HeapEntry SC_Heap_Pop(SC_Heap *heap) {
+  if (heap->length == 0) {
+    SC_PANIC("Trying to pop an empty heap!");
+  }
+
+  SC_HeapEntry top = heap->data[0];
+  SC_HeapEntry last = heap->data[--heap->length];
+
+  size_t i = 0;
+  for (;;) {
+    size_t child = i * 2 + 1;
+    if (child >= heap->length) {
+      break;
+    }
+    if (child + 1 < heap->length &&
+        SC_HeapEntry_Less(heap->data[child + 1], heap->data[child])) {
+      child++;
+    }
+    if (!SC_HeapEntry_Less(heap->data[child], last)) {
+      break;
+    }
+    heap->data[i] = heap->data[child];
+    i = child;
+  }
+  if (heap->length > 0) {
+    heap->data[i] = last;
+  }
+
+  return top;
 }
 
 /**
- * Saves all the state needed to render a single step in the animation.
+ * A binary min-heap of `SC_HeapEntry` that knows where each `idx` is.
  *
- * Each step should own it's memory! So we can free one step and not affect
- * all the others!
+ * Every `idx` must be lower than the capacity and can only be once on the
+ * heap. Knowing the position of each entry allows changing its key or
+ * removing it in O(log n).
  */
 typedef struct {
-  size_t current_process;
-  size_t process_length;
-  SC_Process *processes;
-} SC_SimStepState;
+  SC_HeapEntry *data;
+  size_t length;
+  /** Position of each idx inside `data`, or `SC_NO_HEAP_POSITION`. */
+  size_t *positions;
+  size_t capacity;
+} SC_IndexedHeap;
+
+static const size_t SC_NO_HEAP_POSITION = -1;
+
+void SC_IndexedHeap_Init(SC_IndexedHeap *heap, size_t capacity, SC_Err err) {
+  heap->data = malloc(sizeof(SC_HeapEntry) * (capacity > 0 ? capacity : 1));
+  heap->positions = malloc(sizeof(size_t) * (capacity > 0 ? capacity : 1));
+  if (NULL == heap->data || NULL == heap->positions) {
+    free(heap->data);
+    free(heap->positions);
+    heap->data = NULL;
+    heap->positions = NULL;
+    *err = MALLOC_FAILED;
+    return;
+  }
+
+  for (size_t i = 0; i < capacity; i++) {
+    heap->positions[i] = SC_NO_HEAP_POSITION;
+  }
+  heap->length = 0;
+  heap->capacity = capacity;
+}
+
+void SC_IndexedHeap_Deinit(SC_IndexedHeap *heap) {
+  free(heap->data);
+  free(heap->positions);
+  heap->data = NULL;
+  heap->positions = NULL;
+  heap->length = 0;
+  heap->capacity = 0;
+}
+
+SC_Bool SC_IndexedHeap_Contains(SC_IndexedHeap *heap, size_t idx) {
+  return idx < heap->capacity &&
+         heap->positions[idx] != SC_NO_HEAP_POSITION;
+}
+
+static void SC_IndexedHeap_Place(SC_IndexedHeap *heap, size_t i,
+                                 SC_HeapEntry entry) {
+  heap->data[i] = entry;
+  heap->positions[entry.idx] = i;
+}
+
+static void SC_IndexedHeap_SiftUp(SC_IndexedHeap *heap, size_t i) {
+  SC_HeapEntry entry = heap->data[i];
+  while (i > 0) {
+    size_t parent = (i - 1) / 2;
+    if (!SC_HeapEntry_Less(entry, heap->data[parent])) {
+      break;
+    }
+    SC_IndexedHeap_Place(heap, i, heap->data[parent]);
+    i = parent;
+  }
+  SC_IndexedHeap_Place(heap, i, entry);
+}
+
+static void SC_IndexedHeap_SiftDown(SC_IndexedHeap *heap, size_t i) {
+  SC_HeapEntry entry = heap->data[i];
+  for (;;) {
+    size_t child = i * 2 + 1;
+    if (child >= heap->length) {
+      break;
+    }
+    if (child + 1 < heap->length &&
+        SC_HeapEntry_Less(heap->data[child + 1], heap->data[child])) {
+      child++;
+    }
+    if (!SC_HeapEntry_Less(heap->data[child], entry)) {
+      break;
+    }
+    SC_IndexedHeap_Place(heap, i, heap->data[child]);
+    i = child;
+  }
+  SC_IndexedHeap_Place(heap, i, entry);
+}
+
+void SC_IndexedHeap_Push(SC_IndexedHeap *heap, SC_HeapEntry entry) {
+  if (entry.idx >= heap->capacity) {
+    SC_PANIC("Trying to push idx %zu on an indexed heap of capacity %zu!",
+             entry.idx, heap->capacity);
+  }
+  if (SC_IndexedHeap_Contains(heap, entry.idx)) {
+    SC_PANIC("Trying to push idx %zu twice on an indexed heap!", entry.idx);
+  }
+
+  heap->data[heap->length] = entry;
+  SC_IndexedHeap_SiftUp(heap, heap->length++);
+}
+
+SC_HeapEntry SC_IndexedHeap_Peek(SC_IndexedHeap *heap) {
+  if (heap->length == 0) {
+    SC_PANIC("Trying to peek an empty indexed heap!");
+  }
+  return heap->data[0];
+}
 
 /**
- * Saves all the steps a simulation can have.
+ * Removes `idx` from the heap and returns its entry.
  */
-typedef struct {
-  size_t step_length;
-  size_t current_step;
-  float avg_waiting_time;
-  SC_SimStepState *steps;
-} SC_Simulation;
+SC_HeapEntry SC_IndexedHeap_Remove(SC_IndexedHeap *heap, size_t idx) {
+  if (!SC_IndexedHeap_Contains(heap, idx)) {
+    SC_PANIC("Trying to remove idx %zu that isn't on the indexed heap!", idx);
+  }
+
+  size_t i = heap->positions[idx];
+  SC_HeapEntry removed = heap->data[i];
+  heap->positions[idx] = SC_NO_HEAP_POSITION;
+
+  SC_HeapEntry last = heap->data[--heap->length];
+  if (i < heap->length) {
+    SC_IndexedHeap_Place(heap, i, last);
+    SC_IndexedHeap_SiftUp(heap, i);
+    SC_IndexedHeap_SiftDown(heap, heap->positions[last.idx]);
+  }
 
-SC_Process SC_Verify_AT_BT(SC_ProcessList *list, int step);
-static int compare_proc_ptr(const void *a, const void *b) {
-  const SC_Process *pa = *(const SC_Process **)a;
-  const SC_Process *pb = *(const SC_Process **)b;
-  return compare_by_arrival_time(*pa, *pb);
+  return removed;
 }
+
+SC_HeapEntry SC_IndexedHeap_Pop(SC_IndexedHeap *heap) {
+  return SC_IndexedHeap_Remove(heap, SC_IndexedHeap_Peek(heap).idx);
+}
+
 /**
- * Computes the FIFO scheduling simulation
+ * Lowers the key of `idx`, it must already be on the heap.
+ */
+void SC_IndexedHeap_DecreaseKey(SC_IndexedHeap *heap, size_t idx,
+                                SC_Time key) {
+  if (!SC_IndexedHeap_Contains(heap, idx)) {
+    SC_PANIC("Trying to decrease idx %zu that isn't on the indexed heap!",
+             idx);
+  }
+
+  size_t i = heap->positions[idx];
+  if (key > heap->data[i].key) {
+    SC_PANIC("Trying to increase the key of idx %zu on DecreaseKey!", idx);
+  }
+  heap->data[i].key = key;
+  SC_IndexedHeap_SiftUp(heap, i);
+}
+
+// ===========
+//  RED-BLACK TREES
+// ===========
+
+/**
+ * A red-black tree of slots ordered by `keys[slot]`, ties broken by the
+ * lowest slot.
  *
- * @param processes *SC_ProcessList The initial conditions of each
- * process.
- * @param sim *SC_Simulation The simulation state to fill with all the sim
- * step data.
- * @return SC_Simulation The simulation with all it's steps.
+ * Nodes live on arrays indexed by slot, so every slot must be lower than the
+ * capacity and can only be once on the tree. The key of a slot must not
+ * change while it's on the tree. Inserting and removing cost O(log n), and
+ * the leftmost node is cached so the minimum costs O(1).
  */
-void simulate_first_in_first_out(SC_ProcessList *processes,
-                                 SC_Simulation *sim) {
-  int n = processes->count;
+typedef struct {
+  size_t *left;
+  size_t *right;
+  size_t *parent;
+  SC_Bool *red;
+  const SC_Time *keys;
+  size_t root;
+  /** The leftmost slot, or `nil` if the tree is empty. */
+  size_t leftmost;
+  size_t length;
+  /**
+   * Sentinel used as every leaf and as the parent of the root, it's the slot
+   * right after the capacity.
+   */
+  size_t nil;
+} SC_RbTree;
+
+void SC_RbTree_Init(SC_RbTree *tree, size_t capacity, const SC_Time *keys,
+                    SC_Err err) {
+  tree->left = malloc(sizeof(size_t) * (capacity + 1));
+  tree->right = malloc(sizeof(size_t) * (capacity + 1));
+  tree->parent = malloc(sizeof(size_t) * (capacity + 1));
+  tree->red = malloc(sizeof(SC_Bool) * (capacity + 1));
+  if (!tree->left || !tree->right || !tree->parent || !tree->red) {
+    *err = MALLOC_FAILED;
+    return;
+  }
+
+  tree->keys = keys;
+  tree->nil = capacity;
+  tree->root = capacity;
+  tree->leftmost = capacity;
+  tree->length = 0;
+  tree->red[capacity] = SC_FALSE;
+}
+
+// It's safe to call on a zeroed tree.
+void SC_RbTree_Deinit(SC_RbTree *tree) {
+  free(tree->left);
+  free(tree->right);
+  free(tree->parent);
+  free(tree->red);
+  *tree = (SC_RbTree){0};
+}
 
-  SC_Process **proc_array = malloc(sizeof(SC_Process *) * n);
-  SC_ProcessList_Node *node = processes->head;
-  for (int i = 0; i < n && node != NULL; i++, node = node->next) {
-    proc_array[i] = &node->value;
+static SC_Bool SC_RbTree_Less(SC_RbTree *tree, size_t a, size_t b) {
+  if (tree->keys[a] != tree->keys[b]) {
+    return tree->keys[a] < tree->keys[b];
   }
+  return a < b;
+}
 
-  qsort(proc_array, n, sizeof(SC_Process *), compare_proc_ptrAT);
+// Replaces `node` with `child` on the link from its parent.
+static void SC_RbTree_Replace(SC_RbTree *tree, size_t node, size_t child) {
+  size_t parent = tree->parent[node];
+  if (parent == tree->nil) {
+    tree->root = child;
+  } else if (node == tree->left[parent]) {
+    tree->left[parent] = child;
+  } else {
+    tree->right[parent] = child;
+  }
+  tree->parent[child] = parent;
+}
 
-  int totalBurstTime = 0;
-  for (int i = 0; i < n; i++) {
-    totalBurstTime += proc_array[i]->burst_time;
+static void SC_RbTree_RotateLeft(SC_RbTree *tree, size_t node) {
+  size_t child = tree->right[node];
+  tree->right[node] = tree->left[child];
+  if (tree->left[child] != tree->nil) {
+    tree->parent[tree->left[child]] = node;
   }
+  SC_RbTree_Replace(tree, node, child);
+  tree->left[child] = node;
+  tree->parent[node] = child;
+}
 
-  sim->step_length = totalBurstTime;
-  sim->current_step = 0;
-  sim->steps = malloc(sizeof(SC_SimStepState) * totalBurstTime);
+static void SC_RbTree_RotateRight(SC_RbTree *tree, size_t node) {
+  size_t child = tree->left[node];
+  tree->left[node] = tree->right[child];
+  if (tree->right[child] != tree->nil) {
+    tree->parent[tree->right[child]] = node;
+  }
+  SC_RbTree_Replace(tree, node, child);
+  tree->right[child] = node;
+  tree->parent[node] = child;
+}
 
-  int *remaining_bursts = malloc(sizeof(int) * n);
-  for (int i = 0; i < n; i++) {
-    remaining_bursts[i] = proc_array[i]->burst_time;
+static size_t SC_RbTree_Minimum(SC_RbTree *tree, size_t node) {
+  while (tree->left[node] != tree->nil) {
+    node = tree->left[node];
   }
+  return node;
+}
 
-  int time = 0;
-  int current_time = 0;
+void SC_RbTree_Insert(SC_RbTree *tree, size_t slot) {
+  size_t parent = tree->nil;
+  size_t current = tree->root;
+  SC_Bool leftmost = SC_TRUE;
+  while (current != tree->nil) {
+    parent = current;
+    if (SC_RbTree_Less(tree, slot, current)) {
+      current = tree->left[current];
+    } else {
+      current = tree->right[current];
+      leftmost = SC_FALSE;
+    }
+  }
 
-  for (int pidx = 0; pidx < n; pidx++) {
-    SC_Process *proc = proc_array[pidx];
+  tree->parent[slot] = parent;
+  tree->left[slot] = tree->nil;
+  tree->right[slot] = tree->nil;
+  tree->red[slot] = SC_TRUE;
+  if (parent == tree->nil) {
+    tree->root = slot;
+  } else if (SC_RbTree_Less(tree, slot, parent)) {
+    tree->left[parent] = slot;
+  } else {
+    tree->right[parent] = slot;
+  }
+  if (leftmost) {
+    tree->leftmost = slot;
+  }
+  tree->length++;
+
+  // Fixes two reds in a row, walking up while the uncle is red.
+  size_t node = slot;
+  while (tree->red[tree->parent[node]]) {
+    size_t node_parent = tree->parent[node];
+    size_t grandparent = tree->parent[node_parent];
+    SC_Bool parent_is_left = node_parent == tree->left[grandparent];
+    size_t uncle =
+        parent_is_left ? tree->right[grandparent] : tree->left[grandparent];
+
+    if (tree->red[uncle]) {
+      tree->red[node_parent] = SC_FALSE;
+      tree->red[uncle] = SC_FALSE;
+      tree->red[grandparent] = SC_TRUE;
+      node = grandparent;
+      continue;
+    }
 
-    if (current_time < proc->arrival_time) {
-      current_time = proc->arrival_time;
+    if (parent_is_left) {
+      if (node == tree->right[node_parent]) {
+        node = node_parent;
+        SC_RbTree_RotateLeft(tree, node);
+      }
+      tree->red[tree->parent[node]] = SC_FALSE;
+      tree->red[grandparent] = SC_TRUE;
+      SC_RbTree_RotateRight(tree, grandparent);
+    } else {
+      if (node == tree->left[node_parent]) {
+        node = node_parent;
+        SC_RbTree_RotateRight(tree, node);
+      }
+      tree->red[tree->parent[node]] = SC_FALSE;
+      tree->red[grandparent] = SC_TRUE;
+      SC_RbTree_RotateLeft(tree, grandparent);
     }
+  }
+  tree->red[tree->root] = SC_FALSE;
+}
+
+void SC_RbTree_Remove(SC_RbTree *tree, size_t slot) {
+  if (slot == tree->leftmost) {
+    // The leftmost node has no left child, so the next one is the minimum of
+    // its right subtree or its parent.
+    tree->leftmost = tree->right[slot] != tree->nil
+                         ? SC_RbTree_Minimum(tree, tree->right[slot])
+                         : tree->parent[slot];
+  }
 
-    int waiting_time = current_time;
-    proc->waiting_time = waiting_time;
+  size_t moved = slot;
+  SC_Bool moved_was_red = tree->red[moved];
+  size_t node;
+  if (tree->left[slot] == tree->nil) {
+    node = tree->right[slot];
+    SC_RbTree_Replace(tree, slot, node);
+  } else if (tree->right[slot] == tree->nil) {
+    node = tree->left[slot];
+    SC_RbTree_Replace(tree, slot, node);
+  } else {
+    moved = SC_RbTree_Minimum(tree, tree->right[slot]);
+    moved_was_red = tree->red[moved];
+    node = tree->right[moved];
+    if (tree->parent[moved] == slot) {
+      tree->parent[node] = moved;
+    } else {
+      SC_RbTree_Replace(tree, moved, node);
+      tree->right[moved] = tree->right[slot];
+      tree->parent[tree->right[moved]] = moved;
+    }
+    SC_RbTree_Replace(tree, slot, moved);
+    tree->left[moved] = tree->left[slot];
+    tree->parent[tree->left[moved]] = moved;
+    tree->red[moved] = tree->red[slot];
+  }
+  tree->length--;
 
-    for (int b = 0; b < proc->burst_time; b++) {
-      SC_SimStepState *step = &sim->steps[time];
-      step->current_process = proc->pid_idx;
-      step->process_length = n;
-      step->processes = malloc(sizeof(SC_Process) * n);
+  if (moved_was_red) {
+    return;
+  }
 
-      SC_ProcessList_Node *orig = processes->head;
-      int j = 0;
-      while (orig != NULL) {
-        SC_Process copy = orig->value;
+  // A black node left, so `node` carries an extra black up the tree until it
+  // can be dropped.
+  while (node != tree->root && !tree->red[node]) {
+    size_t parent = tree->parent[node];
+    SC_Bool node_is_left = node == tree->left[parent];
+    size_t sibling = node_is_left ? tree->right[parent] : tree->left[parent];
+
+    if (tree->red[sibling]) {
+      tree->red[sibling] = SC_FALSE;
+      tree->red[parent] = SC_TRUE;
+      if (node_is_left) {
+        SC_RbTree_RotateLeft(tree, parent);
+        sibling = tree->right[parent];
+      } else {
+        SC_RbTree_RotateRight(tree, parent);
+        sibling = tree->left[parent];
+      }
+    }
 
-        for (int k = 0; k < n; k++) {
-          if (copy.pid_idx == proc_array[k]->pid_idx) {
-            int adjusted_burst = remaining_bursts[k] - (k == pidx ? 1 : 0);
-            copy.burst_time = adjusted_burst < 0 ? 0 : adjusted_burst;
-            if (k == pidx) {
-              copy.waiting_time = waiting_time;
-            } else {
-              copy.waiting_time = 0;
-            }
-            break;
-          }
-        }
+    size_t near = node_is_left ? tree->left[sibling] : tree->right[sibling];
+    size_t far = node_is_left ? tree->right[sibling] : tree->left[sibling];
+    if (!tree->red[near] && !tree->red[far]) {
+      tree->red[sibling] = SC_TRUE;
+      node = parent;
+      continue;
+    }
 
-        step->processes[j++] = copy;
-        orig = orig->next;
+    if (!tree->red[far]) {
+      tree->red[near] = SC_FALSE;
+      tree->red[sibling] = SC_TRUE;
+      if (node_is_left) {
+        SC_RbTree_RotateRight(tree, sibling);
+        sibling = tree->right[parent];
+      } else {
+        SC_RbTree_RotateLeft(tree, sibling);
+        sibling = tree->left[parent];
       }
+      far = node_is_left ? tree->right[sibling] : tree->left[sibling];
+    }
 
-      remaining_bursts[pidx]--;
-      time++;
-      current_time++;
+    tree->red[sibling] = tree->red[parent];
+    tree->red[parent] = SC_FALSE;
+    tree->red[far] = SC_FALSE;
+    if (node_is_left) {
+      SC_RbTree_RotateLeft(tree, parent);
+    } else {
+      SC_RbTree_RotateRight(tree, parent);
     }
+    node = tree->root;
+  }
+  tree->red[node] = SC_FALSE;
+}
+
+// ===========
+//  FENWICK TREES
+// ===========
+
+/**
+ * A Fenwick tree of `SC_Time` weights, one per slot.
+ *
+ * Changing a weight, adding up the weights before a slot and finding the
+ * slot a running sum falls on all cost O(log n).
+ */
+typedef struct {
+  /** 1-based, `tree[i]` adds up the weights of the `i & -i` slots up to `i`. */
+  SC_Time *tree;
+  size_t capacity;
+  /** Sum of every weight. */
+  SC_Time total;
+} SC_FenwickTree;
+
+// Every weight starts at 0.
+void SC_FenwickTree_Init(SC_FenwickTree *fenwick, size_t capacity,
+                         SC_Err err) {
+  fenwick->tree = calloc(capacity + 1, sizeof(SC_Time));
+  if (NULL == fenwick->tree) {
+    *err = MALLOC_FAILED;
+    return;
+  }
+  fenwick->capacity = capacity;
+  fenwick->total = 0;
+}
+
+// It's safe to call on a zeroed tree.
+void SC_FenwickTree_Deinit(SC_FenwickTree *fenwick) {
+  free(fenwick->tree);
+  *fenwick = (SC_FenwickTree){0};
+}
+
+void SC_FenwickTree_Add(SC_FenwickTree *fenwick, size_t slot, SC_Time weight) {
+  fenwick->total += weight;
+  for (size_t i = slot + 1; i <= fenwick->capacity; i += i & -i) {
+    fenwick->tree[i] += weight;
   }
+}
+
+// The weight of `slot` must be at least `weight`.
+void SC_FenwickTree_Subtract(SC_FenwickTree *fenwick, size_t slot,
+                             SC_Time weight) {
+  fenwick->total -= weight;
+  for (size_t i = slot + 1; i <= fenwick->capacity; i += i & -i) {
+    fenwick->tree[i] -= weight;
+  }
+}
+
+/**
+ * Returns the slot whose weight covers `target`, the first one where the sum
+ * of the weights up to it is greater than `target`.
+ *
+ * `target` must be lower than the total.
+ */
+size_t SC_FenwickTree_Find(SC_FenwickTree *fenwick, SC_Time target) {
+  if (target >= fenwick->total) {
+    SC_PANIC("Trying to find %" PRIu64 " on a Fenwick tree of total %" PRIu64
+             "!",
+             target, fenwick->total);
+  }
+
+  size_t position = 0;
+  size_t step = 1;
+  while (step * 2 <= fenwick->capacity) {
+    step *= 2;
+  }
+  for (; step > 0; step /= 2) {
+    size_t next = position + step;
+    if (next <= fenwick->capacity && fenwick->tree[next] <= target) {
+      position = next;
+      target -= fenwick->tree[next];
+    }
+  }
+
+  // `position` is 1-based, the slot right after it is the one.
+  return position;
+}
+
+// ===========
+//  KINETIC TOURNAMENTS
+// ===========
+
+/**
+ * A kinetic tournament tree that keeps the slot with the highest response
+ * ratio, `(time - arrival + burst) / burst`, as time goes forward.
+ *
+ * Every ratio is a line over time, so instead of comparing them again on
+ * every query each match stores when its loser would overtake its winner.
+ * Advancing the time only replays the matches whose certificate failed, and
+ * inserting or removing a slot replays its path to the root, all in O(log n).
+ *
+ * Slots must be lower than the capacity and have a burst over 0. Ties go to
+ * the lowest slot. Time can only go forward.
+ */
+typedef struct {
+  /** Winner of each match, or `capacity` if no slot plays on it. */
+  size_t *winner;
+  /** When the loser of each match overtakes its winner. */
+  SC_Time *failure;
+  /** Earliest failure on the subtree of each match. */
+  SC_Time *next_failure;
+  const SC_Time *arrival;
+  const SC_Time *burst;
+  size_t capacity;
+  /** Leaves on the last level, a power of 2. Node 1 is the root. */
+  size_t leaves;
+  size_t length;
+  SC_Time time;
+} SC_KineticTree;
+
+void SC_KineticTree_Init(SC_KineticTree *tree, size_t capacity,
+                         const SC_Time *arrival, const SC_Time *burst,
+                         SC_Err err) {
+  size_t leaves = 1;
+  while (leaves < capacity) {
+    leaves *= 2;
+  }
+
+  tree->winner = malloc(sizeof(size_t) * 2 * leaves);
+  tree->failure = malloc(sizeof(SC_Time) * 2 * leaves);
+  tree->next_failure = malloc(sizeof(SC_Time) * 2 * leaves);
+  if (!tree->winner || !tree->failure || !tree->next_failure) {
+    *err = MALLOC_FAILED;
+    return;
+  }
+
+  for (size_t node = 0; node < 2 * leaves; node++) {
+    tree->winner[node] = capacity;
+    tree->failure[node] = SC_TIME_MAX;
+    tree->next_failure[node] = SC_TIME_MAX;
+  }
+  tree->arrival = arrival;
+  tree->burst = burst;
+  tree->capacity = capacity;
+  tree->leaves = leaves;
+  tree->length = 0;
+  tree->time = 0;
+}
+
+// It's safe to call on a zeroed tree.
+void SC_KineticTree_Deinit(SC_KineticTree *tree) {
+  free(tree->winner);
+  free(tree->failure);
+  free(tree->next_failure);
+  *tree = (SC_KineticTree){0};
+}
+
+// Whether `a` has a higher ratio than `b` at `time`. Both ratios are compared
+// multiplied by both bursts, so they stay exact.
+static SC_Bool SC_KineticTree_Beats(SC_KineticTree *tree, size_t a, size_t b,
+                                    SC_Time time) {
+  unsigned __int128 ratio_a =
+      (unsigned __int128)(time - tree->arrival[a] + tree->burst[a]) *
+      tree->burst[b];
+  unsigned __int128 ratio_b =
+      (unsigned __int128)(time - tree->arrival[b] + tree->burst[b]) *
+      tree->burst[a];
+  if (ratio_a != ratio_b) {
+    return ratio_a > ratio_b;
+  }
+  return a < b;
+}
+
+/**
+ * First time `loser` beats `winner`, `SC_TIME_MAX` if it never does.
+ *
+ * The ratios are equal at `(arrival[l] * burst[w] - arrival[w] * burst[l]) /
+ * (burst[w] - burst[l])`, and only a loser with a shorter burst grows faster.
+ */
+static SC_Time SC_KineticTree_Failure(SC_KineticTree *tree, size_t winner,
+                                      size_t loser) {
+  SC_Time winner_burst = tree->burst[winner];
+  SC_Time loser_burst = tree->burst[loser];
+  if (loser_burst >= winner_burst) {
+    return SC_TIME_MAX;
+  }
+
+  // The winner is ahead now, so the crossing can't be before the arrivals.
+  unsigned __int128 crossing =
+      (unsigned __int128)tree->arrival[loser] * winner_burst -
+      (unsigned __int128)tree->arrival[winner] * loser_burst;
+  SC_Time slope = winner_burst - loser_burst;
+  unsigned __int128 failure = crossing / slope;
+  // On the crossing itself the tie goes to the lowest slot.
+  if (crossing % slope != 0 || loser > winner) {
+    failure++;
+  }
+  return failure < SC_TIME_MAX ? (SC_Time)failure : SC_TIME_MAX;
+}
+
+// Plays the match of `node` again between the winners of its children.
+static void SC_KineticTree_Replay(SC_KineticTree *tree, size_t node) {
+  size_t left = tree->winner[2 * node];
+  size_t right = tree->winner[2 * node + 1];
+  size_t none = tree->capacity;
+
+  if (left == none || right == none) {
+    tree->winner[node] = left == none ? right : left;
+    tree->failure[node] = SC_TIME_MAX;
+  } else if (SC_KineticTree_Beats(tree, left, right, tree->time)) {
+    tree->winner[node] = left;
+    tree->failure[node] = SC_KineticTree_Failure(tree, left, right);
+  } else {
+    tree->winner[node] = right;
+    tree->failure[node] = SC_KineticTree_Failure(tree, right, left);
+  }
+
+  tree->next_failure[node] =
+      SC_Time_Min(tree->failure[node],
+                  SC_Time_Min(tree->next_failure[2 * node],
+                              tree->next_failure[2 * node + 1]));
+}
+
+static void SC_KineticTree_ReplayPath(SC_KineticTree *tree, size_t node) {
+  for (node /= 2; node > 0; node /= 2) {
+    SC_KineticTree_Replay(tree, node);
+  }
+}
+
+/**
+ * Moves the tree forward to `time`, replaying every match whose loser
+ * overtook its winner on the way.
+ */
+void SC_KineticTree_Advance(SC_KineticTree *tree, SC_Time time) {
+  if (time < tree->time) {
+    SC_PANIC("Trying to move a kinetic tree back from %" PRIu64 " to %" PRIu64
+             "!",
+             tree->time, time);
+  }
+  tree->time = time;
+
+  // `SC_TIME_MAX` means no match ever fails, even if the time gets there.
+  while (tree->next_failure[1] != SC_TIME_MAX &&
+         tree->next_failure[1] <= time) {
+    // Follow the earliest failure down to the match that failed.
+    size_t node = 1;
+    while (tree->failure[node] > time) {
+      node = tree->next_failure[2 * node] <= time ? 2 * node : 2 * node + 1;
+    }
+    SC_KineticTree_Replay(tree, node);
+    SC_KineticTree_ReplayPath(tree, node);
+  }
+}
+
+// `slot` joins at the current time, which can't be before its arrival, and
+// it must not be on the tree.
+void SC_KineticTree_Insert(SC_KineticTree *tree, size_t slot) {
+  size_t leaf = tree->leaves + slot;
+  if (slot >= tree->capacity || tree->winner[leaf] != tree->capacity) {
+    SC_PANIC("Trying to insert slot %zu twice or out of a kinetic tree!",
+             slot);
+  }
+  if (tree->burst[slot] == 0) {
+    SC_PANIC("Trying to insert slot %zu without a burst on a kinetic tree!",
+             slot);
+  }
+
+  tree->winner[leaf] = slot;
+  tree->length++;
+  SC_KineticTree_ReplayPath(tree, leaf);
+}
+
+void SC_KineticTree_Remove(SC_KineticTree *tree, size_t slot) {
+  size_t leaf = tree->leaves + slot;
+  if (slot >= tree->capacity || tree->winner[leaf] != slot) {
+    SC_PANIC("Trying to remove slot %zu that isn't on the kinetic tree!",
+             slot);
+  }
+
+  tree->winner[leaf] = tree->capacity;
+  tree->length--;
+  SC_KineticTree_ReplayPath(tree, leaf);
+}
+
+// The slot with the highest ratio at the current time, the tree can't be
+// empty.
+size_t SC_KineticTree_Top(SC_KineticTree *tree) {
+  if (tree->length == 0) {
+    SC_PANIC("Trying to get the top of an empty kinetic tree!");
+  }
+  return tree->winner[1];
+}
+
+// ===========
+//  TIMER WHEELS
+// ===========
+
+// Every level of a timer wheel splits the time in 64 slots, one bit each.
+static const int SC_TIMER_WHEEL_BITS = 6;
+#define SC_TIMER_WHEEL_SLOTS 64
+// Enough levels to cover all the bits of an `SC_Time`.
+#define SC_TIMER_WHEEL_LEVELS 11
+
+/**
+ * A hierarchical timer wheel of ids that expire at some time.
+ *
+ * A timer lives on the level of the highest group of 6 bits where its expiry
+ * differs from the current time, on the slot of that group. Every timer on a
+ * level expires before the ones on the levels above, so the next expiry is
+ * on the first occupied slot of the lowest occupied level, and a bitmap per
+ * level finds it in O(1). As time reaches the slot of a timer it cascades
+ * down a level, at most once per level.
+ *
+ * Timers that expire at the same time always share a slot, which keeps them
+ * in the order they were scheduled, so they pop first come, first served.
+ *
+ * Ids must be lower than the capacity and can have one timer at a time.
+ * Time can only go forward, and timers must be popped once they expire.
+ */
+typedef struct {
+  /** The next id on the same slot, or `capacity` for the last one. */
+  size_t *next;
+  SC_Time *expiry;
+  size_t heads[SC_TIMER_WHEEL_LEVELS][SC_TIMER_WHEEL_SLOTS];
+  /** The last id of each slot, only valid while its head is set. */
+  size_t tails[SC_TIMER_WHEEL_LEVELS][SC_TIMER_WHEEL_SLOTS];
+  uint64_t occupied[SC_TIMER_WHEEL_LEVELS];
+  size_t capacity;
+  size_t length;
+  SC_Time time;
+  /** Cached `SC_TimerWheel_NextExpiry`, valid unless `stale`. */
+  SC_Time next_expiry;
+  SC_Bool stale;
+} SC_TimerWheel;
+
+void SC_TimerWheel_Init(SC_TimerWheel *wheel, size_t capacity, SC_Err err) {
+  wheel->next = malloc(sizeof(size_t) * (capacity > 0 ? capacity : 1));
+  wheel->expiry = malloc(sizeof(SC_Time) * (capacity > 0 ? capacity : 1));
+  if (NULL == wheel->next || NULL == wheel->expiry) {
+    *err = MALLOC_FAILED;
+    return;
+  }
+
+  for (size_t level = 0; level < SC_TIMER_WHEEL_LEVELS; level++) {
+    for (size_t slot = 0; slot < SC_TIMER_WHEEL_SLOTS; slot++) {
+      wheel->heads[level][slot] = capacity;
+    }
+    wheel->occupied[level] = 0;
+  }
+  wheel->capacity = capacity;
+  wheel->length = 0;
+  wheel->time = 0;
+  wheel->next_expiry = SC_TIME_MAX;
+  wheel->stale = SC_FALSE;
+}
+
+// It's safe to call on a zeroed wheel.
+void SC_TimerWheel_Deinit(SC_TimerWheel *wheel) {
+  free(wheel->next);
+  free(wheel->expiry);
+  wheel->next = NULL;
+  wheel->expiry = NULL;
+  wheel->length = 0;
+}
+
+static void SC_TimerWheel_Place(SC_TimerWheel *wheel, size_t id) {
+  SC_Time expiry = wheel->expiry[id];
+  SC_Time diff = expiry ^ wheel->time;
+  int level =
+      diff == 0 ? 0 : (63 - __builtin_clzll(diff)) / SC_TIMER_WHEEL_BITS;
+  size_t slot = (expiry >> (level * SC_TIMER_WHEEL_BITS)) &
+                (SC_TIMER_WHEEL_SLOTS - 1);
+
+  wheel->next[id] = wheel->capacity;
+  if (wheel->heads[level][slot] == wheel->capacity) {
+    wheel->heads[level][slot] = id;
+  } else {
+    wheel->next[wheel->tails[level][slot]] = id;
+  }
+  wheel->tails[level][slot] = id;
+  wheel->occupied[level] |= (uint64_t)1 << slot;
+}
+
+// Places the timers of a slot again, on the lower levels they belong to now,
+// in the same order.
+static void SC_TimerWheel_Cascade(SC_TimerWheel *wheel, int level,
+                                  size_t slot) {
+  size_t id = wheel->heads[level][slot];
+  wheel->heads[level][slot] = wheel->capacity;
+  wheel->occupied[level] &= ~((uint64_t)1 << slot);
+
+  while (id != wheel->capacity) {
+    size_t next = wheel->next[id];
+    SC_TimerWheel_Place(wheel, id);
+    id = next;
+  }
+}
+
+// Makes `id` expire at `expiry`, which can't be before the current time.
+void SC_TimerWheel_Schedule(SC_TimerWheel *wheel, size_t id, SC_Time expiry) {
+  if (id >= wheel->capacity) {
+    SC_PANIC("Trying to schedule id %zu on a timer wheel of %zu!", id,
+             wheel->capacity);
+  }
+  if (expiry < wheel->time) {
+    SC_PANIC("Trying to schedule a timer at %" PRIu64 ", before %" PRIu64 "!",
+             expiry, wheel->time);
+  }
+
+  wheel->expiry[id] = expiry;
+  SC_TimerWheel_Place(wheel, id);
+  wheel->length++;
+  if (!wheel->stale) {
+    wheel->next_expiry = SC_Time_Min(wheel->next_expiry, expiry);
+  }
+}
+
+// The earliest expiry on the wheel, `SC_TIME_MAX` if it's empty.
+SC_Time SC_TimerWheel_NextExpiry(SC_TimerWheel *wheel) {
+  if (!wheel->stale) {
+    return wheel->next_expiry;
+  }
+
+  wheel->stale = SC_FALSE;
+  wheel->next_expiry = SC_TIME_MAX;
+  for (int level = 0; level < SC_TIMER_WHEEL_LEVELS; level++) {
+    if (wheel->occupied[level] == 0) {
+      continue;
+    }
+
+    size_t slot = __builtin_ctzll(wheel->occupied[level]);
+    if (level == 0) {
+      wheel->next_expiry =
+          (wheel->time & ~(SC_Time)(SC_TIMER_WHEEL_SLOTS - 1)) | slot;
+      break;
+    }
+
+    // Slots above the first level span many times, any of them can be first.
+    for (size_t id = wheel->heads[level][slot]; id != wheel->capacity;
+         id = wheel->next[id]) {
+      wheel->next_expiry = SC_Time_Min(wheel->next_expiry, wheel->expiry[id]);
+    }
+    break;
+  }
+  return wheel->next_expiry;
+}
+
+/**
+ * Moves the wheel forward to `time`, every timer that expires before it must
+ * have been popped.
+ */
+void SC_TimerWheel_Advance(SC_TimerWheel *wheel, SC_Time time) {
+  if (time < wheel->time || time > SC_TimerWheel_NextExpiry(wheel)) {
+    SC_PANIC("Trying to move a timer wheel from %" PRIu64 " to %" PRIu64
+             " past its timers!",
+             wheel->time, time);
+  }
+  if (time == wheel->time) {
+    return;
+  }
+  wheel->time = time;
+
+  // Only the slot that holds the new time on each level has timers that now
+  // belong to a lower level, the ones before it would have expired already.
+  for (int level = SC_TIMER_WHEEL_LEVELS - 1; level > 0; level--) {
+    size_t slot = (time >> (level * SC_TIMER_WHEEL_BITS)) &
+                  (SC_TIMER_WHEEL_SLOTS - 1);
+    if (wheel->occupied[level] & ((uint64_t)1 << slot)) {
+      SC_TimerWheel_Cascade(wheel, level, slot);
+      wheel->stale = SC_TRUE;
+    }
+  }
+}
+
+/**
+ * Takes the first timer scheduled of the ones that expire at the current
+ * time into `id`. Returns `SC_FALSE` once there are none left.
+ */
+SC_Bool SC_TimerWheel_Pop(SC_TimerWheel *wheel, size_t *id) {
+  size_t slot = wheel->time & (SC_TIMER_WHEEL_SLOTS - 1);
+  size_t head = wheel->heads[0][slot];
+  if (head == wheel->capacity) {
+    return SC_FALSE;
+  }
+
+  wheel->heads[0][slot] = wheel->next[head];
+  if (wheel->next[head] == wheel->capacity) {
+    wheel->occupied[0] &= ~((uint64_t)1 << slot);
+  }
+  wheel->length--;
+  wheel->stale = SC_TRUE;
+  *id = head;
+  return SC_TRUE;
+}
+
+// ===========
+//  HISTOGRAMS
+// ===========
+
+// Each power of two is split in this many buckets, so a bucket is at most
+// 1/32 of its values wide.
+#define SC_HISTOGRAM_SUB_BUCKET_BITS 5
+#define SC_HISTOGRAM_SUB_BUCKETS (1 << SC_HISTOGRAM_SUB_BUCKET_BITS)
+// Enough buckets for every `SC_Time`.
+#define SC_HISTOGRAM_BUCKETS                                                   \
+  ((64 - SC_HISTOGRAM_SUB_BUCKET_BITS + 1) * SC_HISTOGRAM_SUB_BUCKETS)
+
+/**
+ * A log-bucketed histogram of times.
+ *
+ * Values under `2 * SC_HISTOGRAM_SUB_BUCKETS` are counted exactly, bigger ones
+ * share a bucket with values that differ less than ~3% from them. It uses the
+ * same memory no matter how many values it holds, and a zeroed histogram is
+ * empty.
+ */
+typedef struct {
+  uint64_t counts[SC_HISTOGRAM_BUCKETS];
+  uint64_t total;
+  SC_Time max;
+} SC_Histogram;
+
+static size_t SC_Histogram_BucketOf(SC_Time value) {
+  if (value < 2 * SC_HISTOGRAM_SUB_BUCKETS) {
+    return value;
+  }
+
+  // Keeps the highest `SC_HISTOGRAM_SUB_BUCKET_BITS + 1` bits of the value.
+  int shift = 63 - __builtin_clzll(value) - SC_HISTOGRAM_SUB_BUCKET_BITS;
+  return (size_t)shift * SC_HISTOGRAM_SUB_BUCKETS + (value >> shift);
+}
+
+// Returns the biggest value that falls on `bucket`.
+static SC_Time SC_Histogram_BucketMax(size_t bucket) {
+  if (bucket < 2 * SC_HISTOGRAM_SUB_BUCKETS) {
+    return bucket;
+  }
+
+  int shift = (int)(bucket / SC_HISTOGRAM_SUB_BUCKETS) - 1;
+  SC_Time mantissa =
+      bucket % SC_HISTOGRAM_SUB_BUCKETS + SC_HISTOGRAM_SUB_BUCKETS;
+  return (mantissa << shift) + (((SC_Time)1 << shift) - 1);
+}
+
+void SC_Histogram_Reset(SC_Histogram *histogram) {
+  memset(histogram, 0, sizeof(SC_Histogram));
+}
+
+void SC_Histogram_Record(SC_Histogram *histogram, SC_Time value) {
+  histogram->counts[SC_Histogram_BucketOf(value)]++;
+  histogram->total++;
+  histogram->max = SC_Time_Max(histogram->max, value);
+}
+
+/**
+ * Returns the smallest recorded value that's greater or equal than
+ * `percentile` percent of the values, within the precision of its bucket.
+ *
+ * An empty histogram returns 0.
+ */
+SC_Time SC_Histogram_Percentile(SC_Histogram *histogram, double percentile) {
+  if (histogram->total == 0) {
+    return 0;
+  }
+
+  double exact_rank = percentile / 100.0 * (double)histogram->total;
+  uint64_t rank = (uint64_t)exact_rank;
+  if ((double)rank < exact_rank) {
+    rank++;
+  }
+  if (rank == 0) {
+    rank = 1;
+  }
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < SC_HISTOGRAM_BUCKETS; i++) {
+    seen += histogram->counts[i];
+    if (seen >= rank) {
+      return SC_Time_Min(SC_Histogram_BucketMax(i), histogram->max);
+    }
+  }
+  return histogram->max;
+}
+
+/**
+ * Writes a CSV with a `max, count` row per non-empty bucket, where `max` is
+ * the biggest value that falls on the bucket.
+ */
+void SC_Histogram_Export(SC_Histogram *histogram, FILE *out) {
+  for (size_t i = 0; i < SC_HISTOGRAM_BUCKETS; i++) {
+    if (histogram->counts[i] > 0) {
+      fprintf(out, "%" PRIu64 ", %" PRIu64 "\n",
+              SC_Time_Min(SC_Histogram_BucketMax(i), histogram->max),
+              histogram->counts[i]);
+    }
+  }
+}
+
+// ===========
+//  RANDOM NUMBERS
+// ===========
+
+/**
+ * A seeded xorshift64* generator, the same seed always gives the same
+ * numbers on every platform.
+ */
+typedef struct {
+  uint64_t state;
+} SC_Random;
+
+void SC_Random_Init(SC_Random *random, uint64_t seed) {
+  // splitmix64 spreads close seeds, and the state can never be 0.
+  uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z ^= z >> 31;
+  random->state = z != 0 ? z : 1;
+}
+
+uint64_t SC_Random_Next(SC_Random *random) {
+  random->state ^= random->state >> 12;
+  random->state ^= random->state << 25;
+  random->state ^= random->state >> 27;
+  return random->state * 0x2545F4914F6CDD1DULL;
+}
+
+// Returns a uniform number on (0, 1], it's never 0 so its log is finite.
+double SC_Random_Uniform(SC_Random *random) {
+  return ((SC_Random_Next(random) >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+// Returns a uniform integer from 0 up to `bound`, not including it.
+uint64_t SC_Random_Below(SC_Random *random, uint64_t bound) {
+  return ((unsigned __int128)SC_Random_Next(random) * bound) >> 64;
+}
+
+double SC_Random_Exponential(SC_Random *random, double mean) {
+  return -mean * log(SC_Random_Uniform(random));
+}
+
+// Pareto with shape `alpha` scaled so its mean is `mean`, `alpha` must be
+// greater than 1.
+double SC_Random_Pareto(SC_Random *random, double mean, double alpha) {
+  double scale = mean * (alpha - 1) / alpha;
+  return scale / pow(SC_Random_Uniform(random), 1 / alpha);
+}
+
+// ##################################
+// #                                #
+// #       CALENDARIZER             #
+// #                                #
+// ##################################
+
+typedef struct {
+  size_t pid_idx;
+  SC_Time burst_time;
+  SC_Time arrival_time;
+  SC_Time waiting_time;
+  uint priority;
+  /**
+   * Time between the releases of a periodic task, 0 if the process only
+   * runs once. Each release is a new job with the same burst time.
+   */
+  SC_Time period;
+  /**
+   * Time after each release its job should complete by, 0 for none. For
+   * periodic tasks 0 means the period.
+   */
+  SC_Time deadline;
+  /**
+   * Total time of the I/O bursts between the CPU bursts of the process, 0 if
+   * it only has one. `burst_time` is the total of the CPU bursts.
+   */
+  SC_Time io_time;
+  /** The first of the `cycle_count` cycles of the process on its table. */
+  size_t first_cycle;
+  /** 0 if the process only has one CPU burst. */
+  size_t cycle_count;
+} SC_Process;
+
+// The device of the I/O bursts that just sleep, they never wait for a device.
+static const size_t SC_IO_SLEEP = 0;
+// Devices go from 1 up to, but not including, this one.
+#define SC_IO_MAX_DEVICES 16
+
+/**
+ * A CPU burst of a process and the I/O burst that follows it.
+ */
+typedef struct {
+  SC_Time cpu_time;
+  /** 0 on the last cycle, processes end with a CPU burst. */
+  SC_Time io_time;
+  /** The device the I/O burst waits for, or `SC_IO_SLEEP`. */
+  size_t device;
+} SC_IoCycle;
+
+/**
+ * The initial conditions of every process, stored column by column.
+ *
+ * Each column is a contiguous array with `count` values. A process keeps its
+ * slot for as long as it's on the table and `parse_scheduling_file` appends
+ * them in pid order, so the slot of a process is also its `pid_idx`.
+ */
+typedef struct {
+  size_t count;
+  size_t capacity;
+  size_t *pid_idx;
+  SC_Time *burst_time;
+  SC_Time *arrival_time;
+  uint *priority;
+  SC_Time *waiting_time;
+  SC_Time *period;
+  SC_Time *deadline;
+  SC_Time *io_time;
+  size_t *first_cycle;
+  size_t *cycle_count;
+  /**
+   * The `SC_IoCycle`s of every process that alternates between CPU and I/O
+   * bursts, one after the other. Empty if none does.
+   */
+  SC_Slice cycles;
+} SC_ProcessTable;
+
+SC_Time SC_Total_busrt_time(SC_ProcessTable *table);
+
+/**
+ * Grows every column so they can hold at least `capacity` processes.
+ */
+static void SC_ProcessTable_Reserve(SC_ProcessTable *table, size_t capacity,
+                                    SC_Err err) {
+  if (capacity <= table->capacity) {
+    return;
+  }
+
+  size_t *pid_idx = realloc(table->pid_idx, sizeof(size_t) * capacity);
+  if (NULL == pid_idx) {
+    *err = SLICE_EXPANSION_FAILED;
+    return;
+  }
+  table->pid_idx = pid_idx;
+
+  SC_Time *burst_time = realloc(table->burst_time, sizeof(SC_Time) * capacity);
+  if (NULL == burst_time) {
+    *err = SLICE_EXPANSION_FAILED;
+    return;
+  }
+  table->burst_time = burst_time;
+
+  SC_Time *arrival_time =
+      realloc(table->arrival_time, sizeof(SC_Time) * capacity);
+  if (NULL == arrival_time) {
+    *err = SLICE_EXPANSION_FAILED;
+    return;
+  }
+  table->arrival_time = arrival_time;
+
+  uint *priority = realloc(table->priority, sizeof(uint) * capacity);
+  if (NULL == priority) {
+    *err = SLICE_EXPANSION_FAILED;
+    return;
+  }
+  table->priority = priority;
+
+  SC_Time *waiting_time =
+      realloc(table->waiting_time, sizeof(SC_Time) * capacity);
+  if (NULL == waiting_time) {
+    *err = SLICE_EXPANSION_FAILED;
+    return;
+  }
+  table->waiting_time = waiting_time;
+
+  SC_Time *period = realloc(table->period, sizeof(SC_Time) * capacity);
+  if (NULL == period) {
+    *err = SLICE_EXPANSION_FAILED;
+    return;
+  }
+  table->period = period;
+
+  SC_Time *deadline = realloc(table->deadline, sizeof(SC_Time) * capacity);
+  if (NULL == deadline) {
+    *err = SLICE_EXPANSION_FAILED;
+    return;
+  }
+  table->deadline = deadline;
+
+  SC_Time *io_time = realloc(table->io_time, sizeof(SC_Time) * capacity);
+  if (NULL == io_time) {
+    *err = SLICE_EXPANSION_FAILED;
+    return;
+  }
+  table->io_time = io_time;
+
+  size_t *first_cycle = realloc(table->first_cycle, sizeof(size_t) * capacity);
+  if (NULL == first_cycle) {
+    *err = SLICE_EXPANSION_FAILED;
+    return;
+  }
+  table->first_cycle = first_cycle;
+
+  size_t *cycle_count = realloc(table->cycle_count, sizeof(size_t) * capacity);
+  if (NULL == cycle_count) {
+    *err = SLICE_EXPANSION_FAILED;
+    return;
+  }
+  table->cycle_count = cycle_count;
+
+  table->capacity = capacity;
+}
+
+void SC_ProcessTable_Init(SC_ProcessTable *table, size_t capacity,
+                          SC_Err err) {
+  *table = (SC_ProcessTable){0};
+  SC_ProcessTable_Reserve(table, capacity > 0 ? capacity : 1, err);
+  if (*err != NO_ERROR) {
+    *err = MALLOC_FAILED;
+  }
+}
+
+// It's safe to call on a zeroed table.
+void SC_ProcessTable_Deinit(SC_ProcessTable *table) {
+  free(table->pid_idx);
+  free(table->burst_time);
+  free(table->arrival_time);
+  free(table->priority);
+  free(table->waiting_time);
+  free(table->period);
+  free(table->deadline);
+  free(table->io_time);
+  free(table->first_cycle);
+  free(table->cycle_count);
+  SC_Slice_deinit(&table->cycles);
+  *table = (SC_ProcessTable){0};
+}
+
+/**
+ * Initializes `dst` with a copy of every process on `src`.
+ */
+void SC_ProcessTable_Copy(SC_ProcessTable *dst, SC_ProcessTable *src,
+                          SC_Err err) {
+  size_t n = src->count;
+  SC_ProcessTable_Init(dst, n, err);
+  if (*err != NO_ERROR) {
+    return;
+  }
+
+  memcpy(dst->pid_idx, src->pid_idx, sizeof(size_t) * n);
+  memcpy(dst->burst_time, src->burst_time, sizeof(SC_Time) * n);
+  memcpy(dst->arrival_time, src->arrival_time, sizeof(SC_Time) * n);
+  memcpy(dst->priority, src->priority, sizeof(uint) * n);
+  memcpy(dst->waiting_time, src->waiting_time, sizeof(SC_Time) * n);
+  memcpy(dst->period, src->period, sizeof(SC_Time) * n);
+  memcpy(dst->deadline, src->deadline, sizeof(SC_Time) * n);
+  memcpy(dst->io_time, src->io_time, sizeof(SC_Time) * n);
+  memcpy(dst->first_cycle, src->first_cycle, sizeof(size_t) * n);
+  memcpy(dst->cycle_count, src->cycle_count, sizeof(size_t) * n);
+  dst->count = n;
+
+  size_t cycles = src->cycles.length;
+  if (cycles > 0) {
+    SC_Slice_init(&dst->cycles, sizeof(SC_IoCycle), cycles, err);
+    if (*err != NO_ERROR) {
+      return;
+    }
+    memcpy(dst->cycles.data, src->cycles.data, sizeof(SC_IoCycle) * cycles);
+    dst->cycles.length = cycles;
+  }
+}
+
+SC_Time SC_ProcessTable_MaxBurstTime(SC_ProcessTable *table) {
+  SC_Time max = 0;
+  for (size_t i = 0; i < table->count; i++) {
+    if (table->burst_time[i] > max) {
+      max = table->burst_time[i];
+    }
+  }
+
+  return max;
+}
+
+// Removes every process but keeps the memory for reuse.
+void SC_ProcessTable_Reset(SC_ProcessTable *table) {
+  table->count = 0;
+  table->cycles.length = 0;
+}
+
+// Whether any process on the table alternates between CPU and I/O bursts.
+SC_Bool SC_ProcessTable_HasIo(SC_ProcessTable *table) {
+  return table->cycles.length > 0;
+}
+
+/**
+ * Adds a cycle to the pool of the table, processes point to theirs with
+ * `first_cycle` and `cycle_count`.
+ */
+void SC_ProcessTable_AppendCycle(SC_ProcessTable *table, SC_IoCycle cycle,
+                                 SC_Err err) {
+  if (table->cycles.capacity == 0) {
+    SC_Slice_init(&table->cycles, sizeof(SC_IoCycle), 16, err);
+    if (*err != NO_ERROR) {
+      return;
+    }
+  }
+  SC_Slice_append(&table->cycles, &cycle, err);
+}
+
+SC_IoCycle *SC_ProcessTable_Cycles(SC_ProcessTable *table, size_t slot) {
+  return (SC_IoCycle *)table->cycles.data + table->first_cycle[slot];
+}
+
+void SC_ProcessTable_Append(SC_ProcessTable *table, SC_Process process,
+                            SC_Err err) {
+  if (table->count == table->capacity) {
+    SC_ProcessTable_Reserve(table, table->capacity * 2, err);
+    if (*err != NO_ERROR) {
+      return;
+    }
+  }
+
+  size_t slot = table->count++;
+  table->pid_idx[slot] = process.pid_idx;
+  table->burst_time[slot] = process.burst_time;
+  table->arrival_time[slot] = process.arrival_time;
+  table->priority[slot] = process.priority;
+  table->waiting_time[slot] = process.waiting_time;
+  table->period[slot] = process.period;
+  table->deadline[slot] = process.deadline;
+  table->io_time[slot] = process.io_time;
+  table->first_cycle[slot] = process.first_cycle;
+  table->cycle_count[slot] = process.cycle_count;
+}
+
+/**
+ * Gathers every column of `slot` into a single `SC_Process`.
+ */
+SC_Process SC_ProcessTable_Get(SC_ProcessTable *table, size_t slot) {
+  if (slot >= table->count) {
+    SC_PANIC("Trying to get slot %zu of a table with %zu processes!", slot,
+             table->count);
+  }
+
+  return (SC_Process){
+      .pid_idx = table->pid_idx[slot],
+      .burst_time = table->burst_time[slot],
+      .arrival_time = table->arrival_time[slot],
+      .waiting_time = table->waiting_time[slot],
+      .priority = table->priority[slot],
+      .period = table->period[slot],
+      .deadline = table->deadline[slot],
+      .io_time = table->io_time[slot],
+      .first_cycle = table->first_cycle[slot],
+      .cycle_count = table->cycle_count[slot],
+  };
+}
+
+// Used as `current_process` on the steps where no process was running.
+static const size_t SC_NO_PROCESS = -1;
+// Minimum amount of steps between two keyframes of an `SC_StepStore`.
+static const size_t SC_MIN_KEYFRAME_INTERVAL = 64;
+
+/**
+ * Saves all the state needed to render a single step in the animation.
+ *
+ * Steps are not stored like this, they're rebuilt from the timeline when the
+ * UI needs them. The caller owns the `processes` buffer and it must have
+ * space for at least `process_length` processes.
+ */
+typedef struct {
+  /** The process running on the first CPU, or `SC_NO_PROCESS`. */
+  size_t current_process;
+  size_t process_length;
+  SC_Process *processes;
+  size_t cpu_count;
+  /**
+   * The process running on each CPU. Optional, if it's not `NULL` it must
+   * have space for the `cpu_count` of the simulation.
+   */
+  size_t *cpu_processes;
+} SC_SimStepState;
+
+/**
+ * Rebuilds the steps of a simulation from its timeline when they're needed.
+ *
+ * Steps aren't stored. Every `keyframe_interval` time units a full copy of
+ * the table is saved, but only the first time a step after it is requested,
+ * so the simulation only gets expanded as far as it has been seeked. Any step
+ * is rebuilt by replaying the timeline from the closest keyframe before it,
+ * which costs at most `process_length + keyframe_interval` operations per
+ * CPU.
+ *
+ * The slot of a process is its `pid_idx`.
+ */
+typedef struct {
+  size_t process_length;
+  size_t cpu_count;
+  SC_Time keyframe_interval;
+  /**
+   * `process_length` `SC_Process` per keyframe, keyframe `i` holds the table
+   * right before time `i * keyframe_interval`.
+   */
+  SC_Slice keyframes;
+  /**
+   * `cpu_count` indices per keyframe, the first segment of each CPU timeline
+   * that ends after it.
+   */
+  SC_Slice keyframe_segments;
+} SC_StepStore;
+
+/**
+ * Why a segment of the timeline ended.
+ */
+typedef enum {
+  /** The process consumed all its burst time. */
+  SC_SEGMENT_COMPLETED,
+  /** Another process took the CPU before this one finished. */
+  SC_SEGMENT_PREEMPTED,
+  /** The process consumed its whole quantum. */
+  SC_SEGMENT_QUANTUM_EXPIRED,
+  /** No process was ready to run. */
+  SC_SEGMENT_IDLE,
+  /**
+   * The process was moving from another CPU and warming its cache, it didn't
+   * progress.
+   */
+  SC_SEGMENT_MIGRATION,
+  /** The process finished a CPU burst and went to do I/O. */
+  SC_SEGMENT_BLOCKED,
+  /**
+   * The CPU was switching to the process and refilling its cache, it didn't
+   * progress.
+   */
+  SC_SEGMENT_SWITCH,
+} SC_SegmentReason;
+
+/**
+ * A continuous interval of time where the CPU ran the same process.
+ */
+typedef struct {
+  /** The process that ran, or `SC_NO_PROCESS` if the CPU was idle. */
+  size_t pid_idx;
+  SC_Time start;
+  /** The first time unit after the segment, it's not part of it. */
+  SC_Time end;
+  SC_SegmentReason reason;
+} SC_Segment;
+
+/**
+ * The end of an I/O burst, the process is ready to run again.
+ */
+typedef struct {
+  SC_Time time;
+  size_t pid_idx;
+  /** The length of the I/O burst, without the time it queued for a device. */
+  SC_Time io_time;
+} SC_Wakeup;
+
+/**
+ * What a CPU pays to switch to a different process, in time units where it
+ * makes no progress.
+ *
+ * The cache a process leaves behind cools down while it's away: its refill
+ * grows from 0 to `cache_refill` as the part that's still warm halves every
+ * `cache_half_life`. A process that never ran, or a `cache_half_life` of 0,
+ * always refills it all. A zeroed cost makes switches free.
+ */
+typedef struct {
+  /** Fixed time of every switch, saving and restoring the registers. */
+  SC_Time switch_cost;
+  /** Time to refill the cache of a process that was away for long. */
+  SC_Time cache_refill;
+  SC_Time cache_half_life;
+} SC_SwitchCost;
+
+/**
+ * What a simulation keeps while it runs.
+ */
+typedef enum {
+  /** The timeline and every step, needed to render the simulation. */
+  SC_RECORD_STEPS = 0,
+  /** Only the metrics, for runs that are never rendered. */
+  SC_RECORD_METRICS,
+} SC_RecordMode;
+
+/**
+ * Saves all the steps a simulation can have.
+ *
+ * Simulators only write the `timeline`, it grows with the amount of context
+ * switches instead of the total burst time. The per time unit steps are
+ * rebuilt from it when they're requested.
+ */
+typedef struct {
+  size_t step_length;
+  size_t current_step;
+  /** Set it before simulating, a zeroed simulation records steps. */
+  SC_RecordMode record_mode;
+  /** Set it before simulating too, a zeroed simulation switches for free. */
+  SC_SwitchCost switch_cost;
+  float avg_waiting_time;
+  float avg_turnaround_time;
+  /** Time from the arrival of a process until it runs for the first time. */
+  float avg_response_time;
+  /**
+   * Time processes spent blocked on I/O, their I/O bursts and the time they
+   * queued for a busy device. It's left out of `avg_waiting_time`, which
+   * only counts the time they were ready to run.
+   */
+  float avg_io_waiting_time;
+  /** Processes completed per time unit. */
+  float throughput;
+  /** Fraction of the time the CPUs weren't idle, from 0 to 1. */
+  float cpu_utilization;
+  /** Time when the last process completed. */
+  SC_Time makespan;
+  SC_Time waiting_p50;
+  SC_Time waiting_p90;
+  SC_Time waiting_p99;
+  SC_Time waiting_max;
+  /** Times a CPU went from one process to a different one. */
+  size_t context_switches;
+  /** Time the CPUs spent switching and migrating processes. */
+  SC_Time overhead_time;
+  /**
+   * Fraction of the time the CPUs weren't idle that went to the processes
+   * instead of switching or migrating them, 1 when both are free.
+   */
+  float cpu_efficiency;
+  /** Times a process resumed on a different CPU than the one it left. */
+  size_t migrations;
+  /**
+   * How much longer the busiest CPU ran than the average CPU, 0 when the
+   * work is perfectly balanced.
+   */
+  float load_imbalance;
+  /**
+   * Jain's fairness index of the slowdown of the processes, their turnaround
+   * over their burst time. It's 1 when every process was slowed down the
+   * same and goes down to `1 / n` as a few get all the delay.
+   */
+  float fairness;
+  /**
+   * Jobs released during a real-time simulation, every periodic task
+   * releases one per period. The rest of the simulations leave it at 0.
+   */
+  size_t jobs;
+  /** Jobs that completed after their deadline. */
+  size_t deadline_misses;
+  /**
+   * Percentiles of the time jobs completed after their deadline, jobs that
+   * met it count as 0.
+   */
+  SC_Time lateness_p99;
+  SC_Time lateness_max;
+  size_t process_length;
+  /** Completion time of each process, updated as the simulation runs. */
+  SC_Time *completion;
+  /** First time each process ran, `SC_TIME_MAX` if it hasn't yet. */
+  SC_Time *first_run;
+  size_t cpu_count;
+  /** The last process that ran on each CPU, or `SC_NO_PROCESS`. */
+  size_t *last_pids;
+  /**
+   * When each process last left a CPU, `SC_TIME_MAX` if it never ran. Only
+   * kept when switches refill the cache.
+   */
+  SC_Time *left_at;
+  /**
+   * One timeline per CPU, each with `SC_Segment` ordered by time, one per
+   * context switch. It's `NULL` when only recording metrics.
+   */
+  SC_Slice *timelines;
+  SC_StepStore steps;
+  /**
+   * Time each process spent blocked on I/O. `NULL` unless the simulator
+   * models the I/O bursts, see `SC_Simulation_TrackIo`.
+   */
+  SC_Time *blocked_time;
+  /**
+   * Every `SC_Wakeup` ordered by time, so steps can show the I/O left. Only
+   * recorded with the steps.
+   */
+  SC_Slice wakeups;
+} SC_Simulation;
+
+/**
+ * Initializes the store with the initial state of the processes.
+ */
+void SC_StepStore_Init(SC_StepStore *store, SC_ProcessTable *processes,
+                       size_t cpu_count, SC_Err err) {
+  size_t n = processes->count;
+  store->process_length = n;
+  store->cpu_count = cpu_count;
+  store->keyframe_interval =
+      n > SC_MIN_KEYFRAME_INTERVAL ? n : SC_MIN_KEYFRAME_INTERVAL;
+  store->keyframes = (SC_Slice){0};
+  store->keyframe_segments = (SC_Slice){0};
+
+  SC_Slice_init(&store->keyframes, sizeof(SC_Process), n > 0 ? n : 1, err);
+  if (*err != NO_ERROR) {
+    return;
+  }
+
+  SC_Slice_init(&store->keyframe_segments, sizeof(size_t), cpu_count, err);
+  if (*err != NO_ERROR) {
+    return;
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    SC_Process process = SC_ProcessTable_Get(processes, i);
+    process.waiting_time = 0;
+    SC_Slice_append(&store->keyframes, &process, err);
+    if (*err != NO_ERROR) {
+      return;
+    }
+  }
+
+  size_t first_segment = 0;
+  for (size_t cpu = 0; cpu < cpu_count; cpu++) {
+    SC_Slice_append(&store->keyframe_segments, &first_segment, err);
+    if (*err != NO_ERROR) {
+      return;
+    }
+  }
+}
+
+void SC_StepStore_Deinit(SC_StepStore *store) {
+  SC_Slice_deinit(&store->keyframes);
+  SC_Slice_deinit(&store->keyframe_segments);
+}
+
+/**
+ * Drops the keyframes after `time`, once the timeline after it changed.
+ */
+void SC_StepStore_Truncate(SC_StepStore *store, SC_Time time) {
+  size_t keyframe_count = time / store->keyframe_interval + 1;
+  if (keyframe_count * store->cpu_count < store->keyframe_segments.length) {
+    store->keyframe_segments.length = keyframe_count * store->cpu_count;
+    store->keyframes.length = keyframe_count * store->process_length;
+  }
+}
+
+/**
+ * Runs the timeline from `from` until `to` on `table`.
+ *
+ * `*segment` is where to start looking for the first segment that ends after
+ * `from`, and it ends up pointing to the first one that ends after `to`.
+ *
+ * Periodic tasks show the time left on their current job, once a job
+ * completes they get the burst time they had on the `initial` table back.
+ */
+static void SC_Timeline_Replay(SC_Slice *timeline, SC_Process *table,
+                               const SC_Process *initial, size_t *segment,
+                               SC_Time from, SC_Time to) {
+  SC_Segment *segments = timeline->data;
+  size_t i = *segment;
+  while (i < timeline->length && segments[i].end <= from) {
+    i++;
+  }
+
+  for (; i < timeline->length && segments[i].start < to; i++) {
+    SC_Segment *current = &segments[i];
+    if (current->pid_idx != SC_NO_PROCESS &&
+        current->reason != SC_SEGMENT_MIGRATION &&
+        current->reason != SC_SEGMENT_SWITCH) {
+      SC_Time start = SC_Time_Max(current->start, from);
+      SC_Time end = SC_Time_Min(current->end, to);
+      table[current->pid_idx].burst_time -= end - start;
+
+      if (table[current->pid_idx].period > 0 &&
+          current->reason == SC_SEGMENT_COMPLETED && current->end <= to) {
+        table[current->pid_idx].burst_time =
+            initial[current->pid_idx].burst_time;
+      }
+    }
+
+    if (current->end > to) {
+      break;
+    }
+  }
+
+  *segment = i;
+}
+
+/**
+ * Takes the I/O bursts that ended after `from` and up to `to` off `table`.
+ */
+static void SC_Wakeups_Replay(SC_Slice *wakeups, SC_Process *table,
+                              SC_Time from, SC_Time to) {
+  SC_Wakeup *entries = wakeups->data;
+
+  // Looks for the first wakeup after `from`.
+  size_t low = 0;
+  size_t high = wakeups->length;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (entries[mid].time <= from) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+
+  for (size_t i = low; i < wakeups->length && entries[i].time <= to; i++) {
+    table[entries[i].pid_idx].io_time -= entries[i].io_time;
+  }
+}
+
+/**
+ * Returns the process running on the time unit `time`, or `SC_NO_PROCESS`.
+ */
+static size_t SC_Timeline_ProcessAt(SC_Slice *timeline, SC_Time time) {
+  SC_Segment *segments = timeline->data;
+
+  // Looks for the last segment that starts up to `time`.
+  size_t low = 0;
+  size_t high = timeline->length;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (segments[mid].start <= time) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+
+  if (low == 0 || segments[low - 1].end <= time) {
+    return SC_NO_PROCESS;
+  }
+  return segments[low - 1].pid_idx;
+}
+
+/**
+ * Rebuilds the step `idx` into `out`, starting from the closest keyframe.
+ *
+ * The keyframes up to the step are created if they don't exist yet.
+ * `out->processes` must have space for `process_length` processes.
+ */
+void SC_Simulation_GetStep(SC_Simulation *sim, size_t idx,
+                           SC_SimStepState *out, SC_Err err) {
+  if (idx >= sim->step_length) {
+    SC_PANIC("Trying to access step %zu of %zu!", idx, sim->step_length);
+    return;
+  }
+
+  SC_StepStore *store = &sim->steps;
+  size_t n = store->process_length;
+  size_t cpu_count = store->cpu_count;
+  SC_Time interval = store->keyframe_interval;
+
+  // A step shows the processes after its time unit ran.
+  SC_Time time = (SC_Time)idx + 1;
+  size_t keyframe = time / interval;
+
+  while (store->keyframe_segments.length / cpu_count <= keyframe) {
+    size_t last = store->keyframe_segments.length / cpu_count - 1;
+
+    SC_Process *keyframes = store->keyframes.data;
+    memcpy(out->processes, keyframes + last * n, sizeof(SC_Process) * n);
+    for (size_t cpu = 0; cpu < cpu_count; cpu++) {
+      size_t *segments = store->keyframe_segments.data;
+      size_t segment = segments[last * cpu_count + cpu];
+      SC_Timeline_Replay(&sim->timelines[cpu], out->processes, keyframes,
+                         &segment, last * interval, (last + 1) * interval);
+      SC_Slice_append(&store->keyframe_segments, &segment, err);
+      if (*err != NO_ERROR) {
+        return;
+      }
+    }
+    SC_Wakeups_Replay(&sim->wakeups, out->processes, last * interval,
+                      (last + 1) * interval);
+
+    for (size_t i = 0; i < n; i++) {
+      SC_Slice_append(&store->keyframes, &out->processes[i], err);
+      if (*err != NO_ERROR) {
+        return;
+      }
+    }
+  }
+
+  SC_Process *keyframes = store->keyframes.data;
+  size_t *segments = store->keyframe_segments.data;
+  memcpy(out->processes, keyframes + keyframe * n, sizeof(SC_Process) * n);
+  for (size_t cpu = 0; cpu < cpu_count; cpu++) {
+    size_t segment = segments[keyframe * cpu_count + cpu];
+    SC_Timeline_Replay(&sim->timelines[cpu], out->processes, keyframes,
+                       &segment, keyframe * interval, time);
+
+    if (NULL != out->cpu_processes) {
+      out->cpu_processes[cpu] =
+          SC_Timeline_ProcessAt(&sim->timelines[cpu], idx);
+    }
+  }
+  SC_Wakeups_Replay(&sim->wakeups, out->processes, keyframe * interval, time);
+
+  out->current_process = SC_Timeline_ProcessAt(&sim->timelines[0], idx);
+  out->process_length = n;
+  out->cpu_count = cpu_count;
+}
+
+/**
+ * Whether the process on `slot` of a step is blocked on I/O, given its
+ * initial state on `table`. Only steps of simulations that track the I/O
+ * take the I/O bursts off the processes.
+ *
+ * It's blocked once it completed more CPU bursts than I/O bursts, without
+ * completing the last CPU burst.
+ */
+SC_Bool SC_ProcessTable_IsBlocked(SC_ProcessTable *table, size_t slot,
+                                  SC_Process *step) {
+  SC_Time cpu_done = table->burst_time[slot] - step->burst_time;
+  SC_Time io_done = table->io_time[slot] - step->io_time;
+  SC_IoCycle *cycles = SC_ProcessTable_Cycles(table, slot);
+  size_t count = table->cycle_count[slot];
+
+  for (size_t i = 0; i + 1 < count; i++) {
+    if (cpu_done < cycles[i].cpu_time) {
+      return SC_FALSE;
+    }
+    cpu_done -= cycles[i].cpu_time;
+    if (io_done < cycles[i].io_time) {
+      return SC_TRUE;
+    }
+    io_done -= cycles[i].io_time;
+  }
+  return SC_FALSE;
+}
+
+/**
+ * Prepares an empty simulation of `cpu_count` CPUs for the supplied
+ * processes.
+ *
+ * The simulation must not hold any steps, call `SC_Simulation_Deinit` first
+ * if it does.
+ */
+void SC_Simulation_InitCpus(SC_Simulation *sim, SC_ProcessTable *processes,
+                            size_t cpu_count, SC_Err err) {
+  size_t n = processes->count;
+  sim->step_length = 0;
+  sim->current_step = 0;
+  sim->avg_waiting_time = 0;
+  sim->avg_turnaround_time = 0;
+  sim->avg_response_time = 0;
+  sim->avg_io_waiting_time = 0;
+  sim->throughput = 0;
+  sim->cpu_utilization = 0;
+  sim->makespan = 0;
+  sim->waiting_p50 = 0;
+  sim->waiting_p90 = 0;
+  sim->waiting_p99 = 0;
+  sim->waiting_max = 0;
+  sim->context_switches = 0;
+  sim->overhead_time = 0;
+  sim->cpu_efficiency = 1;
+  sim->migrations = 0;
+  sim->load_imbalance = 0;
+  sim->fairness = 0;
+  sim->jobs = 0;
+  sim->deadline_misses = 0;
+  sim->lateness_p99 = 0;
+  sim->lateness_max = 0;
+  sim->process_length = n;
+  sim->cpu_count = cpu_count;
+  sim->timelines = NULL;
+  sim->steps = (SC_StepStore){0};
+  sim->blocked_time = NULL;
+  sim->wakeups = (SC_Slice){0};
+  sim->left_at = NULL;
+
+  sim->completion = malloc(sizeof(SC_Time) * (n > 0 ? n : 1));
+  sim->first_run = malloc(sizeof(SC_Time) * (n > 0 ? n : 1));
+  sim->last_pids = malloc(sizeof(size_t) * cpu_count);
+  if (NULL == sim->completion || NULL == sim->first_run ||
+      NULL == sim->last_pids) {
+    *err = MALLOC_FAILED;
+    return;
+  }
+  for (size_t cpu = 0; cpu < cpu_count; cpu++) {
+    sim->last_pids[cpu] = SC_NO_PROCESS;
+  }
+  // Processes that never run complete as soon as they arrive.
+  for (size_t i = 0; i < n; i++) {
+    sim->completion[i] = processes->arrival_time[i] + processes->burst_time[i];
+    sim->first_run[i] = SC_TIME_MAX;
+  }
+
+  if (sim->switch_cost.cache_refill > 0) {
+    sim->left_at = malloc(sizeof(SC_Time) * (n > 0 ? n : 1));
+    if (NULL == sim->left_at) {
+      *err = MALLOC_FAILED;
+      return;
+    }
+    for (size_t i = 0; i < n; i++) {
+      sim->left_at[i] = SC_TIME_MAX;
+    }
+  }
+
+  if (sim->record_mode == SC_RECORD_METRICS) {
+    return;
+  }
+
+  SC_StepStore_Init(&sim->steps, processes, cpu_count, err);
+  if (*err != NO_ERROR) {
+    return;
+  }
+
+  // Zeroed, so `SC_Simulation_Deinit` works if one of them fails.
+  sim->timelines = calloc(cpu_count, sizeof(SC_Slice));
+  if (NULL == sim->timelines) {
+    *err = MALLOC_FAILED;
+    return;
+  }
+  size_t capacity = n / cpu_count > 0 ? n / cpu_count : 1;
+  for (size_t cpu = 0; cpu < cpu_count; cpu++) {
+    SC_Slice_init(&sim->timelines[cpu], sizeof(SC_Segment), capacity, err);
+    if (*err != NO_ERROR) {
+      return;
+    }
+  }
+}
+
+/**
+ * Prepares an empty single CPU simulation for the supplied processes.
+ *
+ * The simulation must not hold any steps, call `SC_Simulation_Deinit` first
+ * if it does.
+ */
+void SC_Simulation_Init(SC_Simulation *sim, SC_ProcessTable *processes,
+                        SC_Err err) {
+  SC_Simulation_InitCpus(sim, processes, 1, err);
+}
+
+/**
+ * Makes the simulation keep the time processes spend blocked on I/O, for the
+ * simulators that model the I/O bursts. Call it after initializing it.
+ */
+void SC_Simulation_TrackIo(SC_Simulation *sim, SC_Err err) {
+  size_t n = sim->process_length;
+  sim->blocked_time = calloc(n > 0 ? n : 1, sizeof(SC_Time));
+  if (NULL == sim->blocked_time) {
+    *err = MALLOC_FAILED;
+    return;
+  }
+
+  if (sim->record_mode == SC_RECORD_STEPS) {
+    SC_Slice_init(&sim->wakeups, sizeof(SC_Wakeup), n > 0 ? n : 1, err);
+  }
+}
+
+// Frees all the steps of the simulation.
+// It's safe to call on a zeroed simulation.
+void SC_Simulation_Deinit(SC_Simulation *sim) {
+  SC_StepStore_Deinit(&sim->steps);
+  if (NULL != sim->timelines) {
+    for (size_t cpu = 0; cpu < sim->cpu_count; cpu++) {
+      SC_Slice_deinit(&sim->timelines[cpu]);
+    }
+  }
+  free(sim->timelines);
+  free(sim->completion);
+  free(sim->first_run);
+  free(sim->last_pids);
+  free(sim->blocked_time);
+  free(sim->left_at);
+  SC_Slice_deinit(&sim->wakeups);
+  sim->blocked_time = NULL;
+  sim->left_at = NULL;
+  sim->timelines = NULL;
+  sim->completion = NULL;
+  sim->first_run = NULL;
+  sim->last_pids = NULL;
+  sim->step_length = 0;
+  sim->current_step = 0;
+}
+
+/**
+ * Registers that `pid_idx` ran on `cpu` from `start` until `end`.
+ *
+ * If the last segment of the CPU belongs to the same process and ends at
+ * `start` it's extended instead, so a process that keeps the CPU only has one
+ * segment. Switches and migrations are never merged, they don't count as
+ * running, and neither are the jobs of a periodic task, so each one ends in
+ * its own `SC_SEGMENT_COMPLETED`.
+ *
+ * The kernels that know the `record_mode` at compile time pass it as a
+ * constant, so it's never checked. `SC_Simulation_RunOn` uses the one of
+ * `sim`.
+ */
+SC_ALWAYS_INLINE void
+SC_Simulation_RunOnAs(SC_Simulation *sim, size_t cpu, size_t pid_idx,
+                      SC_Time start, SC_Time end, SC_SegmentReason reason,
+                      SC_RecordMode record_mode, SC_Err err) {
+  if (end <= start) {
+    return;
+  }
+  if (cpu >= sim->cpu_count) {
+    SC_PANIC("Trying to run on CPU %zu of %zu!", cpu, sim->cpu_count);
+  }
+
+  if (pid_idx != SC_NO_PROCESS) {
+    if (pid_idx >= sim->process_length) {
+      SC_PANIC("Trying to run process %zu of %zu!", pid_idx,
+               sim->process_length);
+    }
+    size_t last_pid = sim->last_pids[cpu];
+    if (last_pid != SC_NO_PROCESS && last_pid != pid_idx) {
+      sim->context_switches++;
+    }
+    sim->last_pids[cpu] = pid_idx;
+    SC_Bool overhead =
+        reason == SC_SEGMENT_MIGRATION || reason == SC_SEGMENT_SWITCH;
+    if (overhead) {
+      sim->overhead_time += end - start;
+    } else if (sim->first_run[pid_idx] == SC_TIME_MAX) {
+      sim->first_run[pid_idx] = start;
+    }
+    if (reason == SC_SEGMENT_COMPLETED) {
+      sim->completion[pid_idx] = end;
+    }
+    if (NULL != sim->left_at) {
+      sim->left_at[pid_idx] = end;
+    }
+  }
+
+  if (record_mode == SC_RECORD_METRICS) {
+    return;
+  }
+
+  SC_Slice *timeline = &sim->timelines[cpu];
+  SC_Segment *segments = timeline->data;
+  if (timeline->length > 0) {
+    SC_Segment *last = &segments[timeline->length - 1];
+    if (last->pid_idx == pid_idx && last->end == start &&
+        last->reason != SC_SEGMENT_MIGRATION &&
+        last->reason != SC_SEGMENT_SWITCH &&
+        last->reason != SC_SEGMENT_COMPLETED &&
+        reason != SC_SEGMENT_MIGRATION && reason != SC_SEGMENT_SWITCH) {
+      last->end = end;
+      last->reason = reason;
+      return;
+    }
+  }
+
+  SC_Segment segment = {
+      .pid_idx = pid_idx,
+      .start = start,
+      .end = end,
+      .reason = reason,
+  };
+  SC_Slice_append(timeline, &segment, err);
+}
+
+void SC_Simulation_RunOn(SC_Simulation *sim, size_t cpu, size_t pid_idx,
+                         SC_Time start, SC_Time end, SC_SegmentReason reason,
+                         SC_Err err) {
+  SC_Simulation_RunOnAs(sim, cpu, pid_idx, start, end, reason,
+                        sim->record_mode, err);
+}
+
+/**
+ * Registers that `pid_idx` ran on the first CPU from `start` until `end`.
+ */
+void SC_Simulation_Run(SC_Simulation *sim, size_t pid_idx, SC_Time start,
+                       SC_Time end, SC_SegmentReason reason, SC_Err err) {
+  SC_Simulation_RunOn(sim, 0, pid_idx, start, end, reason, err);
+}
+
+/**
+ * Returns the time `cpu` needs to switch to `pid_idx` at `time`, 0 if it's
+ * the last process that ran on it.
+ */
+SC_Time SC_Simulation_SwitchCost(SC_Simulation *sim, size_t cpu,
+                                 size_t pid_idx, SC_Time time) {
+  SC_SwitchCost *cost = &sim->switch_cost;
+  if (sim->last_pids[cpu] == pid_idx) {
+    return 0;
+  }
+
+  SC_Time refill = cost->cache_refill;
+  if (NULL != sim->left_at && cost->cache_half_life > 0 &&
+      sim->left_at[pid_idx] != SC_TIME_MAX) {
+    SC_Time away =
+        time > sim->left_at[pid_idx] ? time - sim->left_at[pid_idx] : 0;
+    double cold = 1 - pow(2, -(double)away / cost->cache_half_life);
+    refill = (SC_Time)(cost->cache_refill * cold + 0.5);
+  }
+  return cost->switch_cost + refill;
+}
+
+/**
+ * Switches the first CPU to `pid_idx` at `time` and returns when it starts
+ * making progress.
+ */
+SC_Time SC_Simulation_Switch(SC_Simulation *sim, size_t pid_idx, SC_Time time,
+                             SC_Err err) {
+  SC_Time until = time + SC_Simulation_SwitchCost(sim, 0, pid_idx, time);
+  SC_Simulation_Run(sim, pid_idx, time, until, SC_SEGMENT_SWITCH, err);
+  return until;
+}
+
+/**
+ * Registers that `pid_idx` finished an I/O burst of `io_time` at `time`,
+ * after blocking at `blocked_since`.
+ */
+void SC_Simulation_Wake(SC_Simulation *sim, size_t pid_idx,
+                        SC_Time blocked_since, SC_Time time, SC_Time io_time,
+                        SC_Err err) {
+  sim->blocked_time[pid_idx] += time - blocked_since;
+  if (sim->record_mode == SC_RECORD_METRICS) {
+    return;
+  }
+
+  SC_Wakeup wakeup = {.time = time, .pid_idx = pid_idx, .io_time = io_time};
+  SC_Slice_append(&sim->wakeups, &wakeup, err);
+}
+
+/**
+ * Running sums of Jain's fairness index over the slowdown of each process.
+ */
+typedef struct {
+  double sum;
+  double sum_of_squares;
+  size_t count;
+} SC_JainIndex;
+
+// Processes that take no time can't be slowed down, they're skipped.
+static void SC_JainIndex_Record(SC_JainIndex *index, SC_Time turnaround,
+                                SC_Time burst) {
+  if (burst == 0) {
+    return;
+  }
+  double slowdown = (double)turnaround / burst;
+  index->sum += slowdown;
+  index->sum_of_squares += slowdown * slowdown;
+  index->count++;
+}
+
+// `(sum x)^2 / (n * sum x^2)`, 1 when there's nothing to compare.
+static float SC_JainIndex_Compute(SC_JainIndex *index) {
+  if (index->count == 0 || index->sum_of_squares == 0) {
+    return 1;
+  }
+  return index->sum * index->sum / (index->count * index->sum_of_squares);
+}
+
+// The fraction of `busy_time` plus the overhead that went to the processes.
+static float SC_Simulation_Efficiency(SC_Simulation *sim, SC_Time busy_time) {
+  SC_Time total = busy_time + sim->overhead_time;
+  return total > 0 ? (double)busy_time / total : 1;
+}
+
+/**
+ * Computes the waiting time of every process and the metrics of the
+ * simulation, in a single pass over the processes.
+ *
+ * The waiting time of a process is the time it spent on the system without
+ * running: `completion - arrival - burst`, minus the time it was blocked on
+ * I/O if the simulator models it. Its percentiles come from a
+ * histogram, so they don't need to sort or copy the waiting times.
+ */
+static void SC_Simulation_ComputeMetrics(SC_Simulation *sim,
+                                         SC_ProcessTable *processes) {
+  size_t n = processes->count;
+  SC_Time *completion = sim->completion;
+  SC_Histogram waiting_times;
+  SC_Histogram_Reset(&waiting_times);
+
+  double total_waiting_time = 0;
+  double total_turnaround_time = 0;
+  double total_response_time = 0;
+  double total_io_waiting_time = 0;
+  SC_Time busy_time = 0;
+  SC_Time makespan = 0;
+  SC_JainIndex slowdowns = {0};
+  for (size_t i = 0; i < n; i++) {
+    SC_Time arrival = processes->arrival_time[i];
+    SC_Time ready_time = arrival + processes->burst_time[i];
+    if (NULL != sim->blocked_time) {
+      ready_time += sim->blocked_time[i];
+      total_io_waiting_time += sim->blocked_time[i];
+    }
+    processes->waiting_time[i] =
+        completion[i] > ready_time ? completion[i] - ready_time : 0;
+    SC_Histogram_Record(&waiting_times, processes->waiting_time[i]);
+
+    // Processes that never ran are answered as soon as they arrive.
+    SC_Time first_run =
+        sim->first_run[i] == SC_TIME_MAX ? arrival : sim->first_run[i];
+
+    // Shortest First and Priority ignore arrivals, so a process can run
+    // before it arrives. It's counted as if it ran right when it arrived.
+    SC_Time turnaround = completion[i] > arrival ? completion[i] - arrival : 0;
+    total_waiting_time += processes->waiting_time[i];
+    total_turnaround_time += turnaround;
+    SC_JainIndex_Record(&slowdowns, turnaround, processes->burst_time[i]);
+    total_response_time += first_run > arrival ? first_run - arrival : 0;
+    busy_time += processes->burst_time[i];
+    makespan = SC_Time_Max(makespan, completion[i]);
+  }
+
+  sim->avg_waiting_time = n > 0 ? total_waiting_time / n : 0;
+  sim->avg_turnaround_time = n > 0 ? total_turnaround_time / n : 0;
+  sim->avg_response_time = n > 0 ? total_response_time / n : 0;
+  sim->avg_io_waiting_time = n > 0 ? total_io_waiting_time / n : 0;
+  sim->makespan = makespan;
+  sim->throughput = makespan > 0 ? (double)n / makespan : 0;
+  sim->cpu_utilization =
+      makespan > 0 ? (double)busy_time / makespan / sim->cpu_count : 0;
+  sim->waiting_p50 = SC_Histogram_Percentile(&waiting_times, 50);
+  sim->waiting_p90 = SC_Histogram_Percentile(&waiting_times, 90);
+  sim->waiting_p99 = SC_Histogram_Percentile(&waiting_times, 99);
+  sim->waiting_max = waiting_times.max;
+  sim->fairness = SC_JainIndex_Compute(&slowdowns);
+  sim->cpu_efficiency = SC_Simulation_Efficiency(sim, busy_time);
+}
+
+/**
+ * Computes the metrics and the amount of steps of a simulation once its
+ * timeline is complete.
+ */
+static void SC_Simulation_Finish(SC_Simulation *sim,
+                                 SC_ProcessTable *processes, SC_Err err) {
+  SC_Simulation_ComputeMetrics(sim, processes);
+  if (sim->record_mode == SC_RECORD_METRICS) {
+    return;
+  }
+
+  // There's one step per time unit, until the end of the last segment.
+  sim->step_length = 0;
+  for (size_t cpu = 0; cpu < sim->cpu_count; cpu++) {
+    SC_Segment *segments = sim->timelines[cpu].data;
+    size_t length = sim->timelines[cpu].length;
+    if (length > 0 && segments[length - 1].end > sim->step_length) {
+      sim->step_length = segments[length - 1].end;
+    }
+  }
+}
+
+static const char *SC_SegmentReason_ToString(SC_SegmentReason reason) {
+  switch (reason) {
+  case SC_SEGMENT_COMPLETED:
+    return "COMPLETED";
+  case SC_SEGMENT_PREEMPTED:
+    return "PREEMPTED";
+  case SC_SEGMENT_QUANTUM_EXPIRED:
+    return "QUANTUM_EXPIRED";
+  case SC_SEGMENT_IDLE:
+    return "IDLE";
+  case SC_SEGMENT_MIGRATION:
+    return "MIGRATION";
+  case SC_SEGMENT_BLOCKED:
+    return "BLOCKED";
+  case SC_SEGMENT_SWITCH:
+    return "SWITCH";
+  default:
+    return "UNKNOWN";
+  }
+}
+
+/**
+ * Writes the timelines as a CSV with the columns
+ * `pid, start, end, reason, cpu`, one CPU after the other.
+ *
+ * Idle segments use `<IDLE>` as their pid.
+ */
+void SC_Simulation_ExportTimeline(SC_Simulation *sim, SC_StringList *pid_list,
+                                  FILE *out, SC_Err err) {
+  // The list is walked once, instead of once per segment.
+  const char **pids = malloc(sizeof(char *) * (pid_list->count + 1));
+  if (NULL == pids) {
+    *err = MALLOC_FAILED;
+    return;
+  }
+  struct SC_StringList_Node *node = pid_list->head;
+  for (size_t i = 0; i < pid_list->count; i++, node = node->next) {
+    pids[i] = node->value.data;
+  }
+
+  for (size_t cpu = 0; cpu < sim->cpu_count && *err == NO_ERROR; cpu++) {
+    SC_Segment *segments = sim->timelines[cpu].data;
+    for (size_t i = 0; i < sim->timelines[cpu].length; i++) {
+      SC_Segment *segment = &segments[i];
+      const char *pid = "<IDLE>";
+      if (segment->pid_idx != SC_NO_PROCESS) {
+        if (segment->pid_idx >= pid_list->count) {
+          *err = NOT_FOUND;
+          break;
+        }
+        pid = pids[segment->pid_idx];
+      }
+
+      fprintf(out, "%s, %" PRIu64 ", %" PRIu64 ", %s, %zu\n", pid,
+              segment->start, segment->end,
+              SC_SegmentReason_ToString(segment->reason), cpu);
+    }
+  }
+
+  free(pids);
+}
+
+/**
+ * The engine behind `simulate_policy`, recording with `record_mode`.
+ *
+ * It's event driven: time jumps from an arrival, a completion or the end of
+ * a time slice to the next one, and the policy is only asked then. Processes
+ * that don't need the CPU complete as soon as they're picked, without a
+ * switch. Like the simulators that don't model I/O, it runs the CPU bursts
+ * of a process as a single one.
+ *
+ * It's always inlined, so when `policy` and `record_mode` are constants the
+ * callbacks are called directly, or inlined, and the recording mode that
+ * isn't used compiles out.
+ */
+SC_ALWAYS_INLINE void SC_PolicyEngine_Run(SC_ProcessTable *processes,
+                                          SC_Simulation *sim,
+                                          const SC_Policy *policy,
+                                          SC_RecordMode record_mode,
+                                          SC_Err err) {
+  size_t n = processes->count;
+
+  SC_HeapEntry *arrivals = malloc(sizeof(SC_HeapEntry) * (n > 0 ? n : 1));
+  SC_Time *remaining_time = malloc(sizeof(SC_Time) * (n > 0 ? n : 1));
+  if (NULL == arrivals || NULL == remaining_time) {
+    free(arrivals);
+    free(remaining_time);
+    *err = MALLOC_FAILED;
+    return;
+  }
+  for (size_t i = 0; i < n; i++) {
+    SC_Time arrival = policy->ignores_arrivals ? 0 : processes->arrival_time[i];
+    arrivals[i] = (SC_HeapEntry){.key = arrival, .idx = i};
+    remaining_time[i] = processes->burst_time[i];
+  }
+
+  // If every process is ready at 0 they're already in order.
+  if (!policy->ignores_arrivals) {
+    SC_HeapEntry_Sort(arrivals, n);
+  }
+
+  SC_PolicyState state = {
+      .count = n,
+      .arrival_time = processes->arrival_time,
+      .burst_time = processes->burst_time,
+      .priority = processes->priority,
+      .remaining_time = remaining_time,
+      .data = NULL,
+  };
+  // The simulation is initialised first, so it's as valid as the one of a
+  // built-in simulator even if the policy fails to.
+  SC_Simulation_Init(sim, processes, err);
+  if (*err == NO_ERROR) {
+    policy->init(&state, err);
+  }
+
+  SC_Time time = 0;
+  size_t cursor = 0;
+  size_t completed = 0;
+  size_t running = SC_NO_SLOT;
+  SC_Time slice_end = SC_TIME_MAX;
+  SC_Bool ticked = SC_FALSE;
+
+  while (*err == NO_ERROR && completed < n) {
+    for (; cursor < n && arrivals[cursor].key <= time; cursor++) {
+      SC_HeapEntry arrival = arrivals[cursor];
+      policy->admit(&state, arrival.idx, arrival.key, err);
+      if (*err != NO_ERROR) {
+        break;
+      }
+    }
+    if (*err != NO_ERROR) {
+      break;
+    }
+
+    if (running != SC_NO_SLOT && NULL != policy->preempts &&
+        policy->preempts(&state, running, time)) {
+      policy->on_preempt(&state, running, time, err);
+      if (*err != NO_ERROR) {
+        break;
+      }
+      running = SC_NO_SLOT;
+    }
+
+    SC_Time next_arrival = cursor < n ? arrivals[cursor].key : SC_TIME_MAX;
+
+    if (running == SC_NO_SLOT) {
+      running = policy->pick_next(&state, time);
+      if (running == SC_NO_SLOT) {
+        if (next_arrival == SC_TIME_MAX) {
+          SC_PANIC("Policy `%s` lost %zu processes!", policy->name,
+                   n - completed);
+        }
+        SC_Simulation_RunOnAs(sim, 0, SC_NO_PROCESS, time, next_arrival,
+                              SC_SEGMENT_IDLE, record_mode, err);
+        if (*err != NO_ERROR) {
+          break;
+        }
+        time = next_arrival;
+        continue;
+      }
+      if (running >= n) {
+        SC_PANIC("Policy `%s` picked slot %zu of %zu!", policy->name, running,
+                 n);
+      }
+
+      slice_end = SC_TIME_MAX;
+      ticked = SC_FALSE;
+      if (remaining_time[running] == 0) {
+        completed++;
+        running = SC_NO_SLOT;
+        continue;
+      }
+    }
+
+    // Whatever arrives while the CPU switches may preempt the process
+    // before it progresses.
+    size_t pid_idx = processes->pid_idx[running];
+    SC_Time switched = time + SC_Simulation_SwitchCost(sim, 0, pid_idx, time);
+    SC_Simulation_RunOnAs(sim, 0, pid_idx, time, switched, SC_SEGMENT_SWITCH,
+                          record_mode, err);
+    if (*err != NO_ERROR) {
+      break;
+    }
+    if (switched > time) {
+      time = switched;
+      continue;
+    }
+
+    if (!ticked) {
+      SC_Time slice = policy->on_tick(&state, running, time);
+      if (slice == 0) {
+        SC_PANIC("Policy `%s` gave a process no time to run!", policy->name);
+      }
+      slice_end = slice < SC_TIME_MAX - time ? time + slice : SC_TIME_MAX;
+      ticked = SC_TRUE;
+    }
+
+    SC_Time until = time + remaining_time[running];
+    SC_SegmentReason reason = SC_SEGMENT_COMPLETED;
+    if (slice_end < until) {
+      until = slice_end;
+      reason = SC_SEGMENT_QUANTUM_EXPIRED;
+    }
+    if (NULL != policy->preempts && next_arrival < until) {
+      until = next_arrival;
+      reason = SC_SEGMENT_PREEMPTED;
+    }
+
+    SC_Simulation_RunOnAs(sim, 0, pid_idx, time, until, reason, record_mode,
+                          err);
+    if (*err != NO_ERROR) {
+      break;
+    }
+
+    remaining_time[running] -= until - time;
+    time = until;
+    if (remaining_time[running] == 0) {
+      completed++;
+      running = SC_NO_SLOT;
+    } else if (time == slice_end) {
+      // Like in Round Robin, it goes after the processes that arrived while
+      // it ran but before the ones that arrive now.
+      for (; cursor < n && arrivals[cursor].key < time; cursor++) {
+        SC_HeapEntry arrival = arrivals[cursor];
+        policy->admit(&state, arrival.idx, arrival.key, err);
+        if (*err != NO_ERROR) {
+          break;
+        }
+      }
+      if (*err != NO_ERROR) {
+        break;
+      }
+      policy->on_preempt(&state, running, time, err);
+      running = SC_NO_SLOT;
+    }
+  }
+
+  if (*err == NO_ERROR) {
+    SC_Simulation_Finish(sim, processes, err);
+  }
+
+  policy->deinit(&state);
+  free(arrivals);
+  free(remaining_time);
+}
+
+/**
+ * Simulates the processes with a scheduling `policy`, through its callbacks.
+ */
+void simulate_policy(SC_ProcessTable *processes, SC_Simulation *sim,
+                     const SC_Policy *policy, SC_Err err) {
+  SC_PolicyEngine_Run(processes, sim, policy, sim->record_mode, err);
+}
+
+/**
+ * Simulates a built-in `policy` on kernels specialised for it, one per
+ * recording mode. Metrics-only runs never touch the timeline.
+ */
+SC_ALWAYS_INLINE void SC_PolicyEngine_RunBuiltIn(SC_ProcessTable *processes,
+                                                 SC_Simulation *sim,
+                                                 const SC_Policy *policy,
+                                                 SC_Err err) {
+  if (sim->record_mode == SC_RECORD_METRICS) {
+    SC_PolicyEngine_Run(processes, sim, policy, SC_RECORD_METRICS, err);
+  } else {
+    SC_PolicyEngine_Run(processes, sim, policy, SC_RECORD_STEPS, err);
+  }
+}
+
+/**
+ * The ready processes of a built-in policy, in the order they run.
+ *
+ * FIFO only appends and takes from the front, since processes are admitted
+ * in the order they arrive. The others append too and sort what's left by
+ * their key the next time they pick, so admitting every process before the
+ * first pick, like the policies that ignore arrivals do, sorts them once.
+ * Ties go to the process admitted first.
+ */
+typedef struct {
+  /** Twice the processes, so compacting it is amortized O(1). */
+  SC_HeapEntry *entries;
+  size_t capacity;
+  size_t head;
+  size_t tail;
+  /** If the entries from `head` to `tail` are in the order they run. */
+  SC_Bool sorted;
+} SC_ReadyQueue;
+
+static void SC_ReadyQueue_Push(SC_ReadyQueue *queue, SC_HeapEntry entry) {
+  if (queue->tail == queue->capacity) {
+    memmove(queue->entries, &queue->entries[queue->head],
+            sizeof(SC_HeapEntry) * (queue->tail - queue->head));
+    queue->tail -= queue->head;
+    queue->head = 0;
+  }
+  queue->entries[queue->tail++] = entry;
+}
+
+static void SC_QueuePolicy_Init(SC_PolicyState *state, SC_Err err) {
+  size_t n = state->count;
+  SC_ReadyQueue *ready = malloc(sizeof(SC_ReadyQueue));
+  if (NULL == ready) {
+    *err = MALLOC_FAILED;
+    return;
+  }
+
+  ready->capacity = n > 0 ? 2 * n : 1;
+  ready->entries = malloc(sizeof(SC_HeapEntry) * ready->capacity);
+  if (NULL == ready->entries) {
+    free(ready);
+    *err = MALLOC_FAILED;
+    return;
+  }
+  ready->head = 0;
+  ready->tail = 0;
+  ready->sorted = SC_TRUE;
+  state->data = ready;
+}
+
+static void SC_QueuePolicy_Deinit(SC_PolicyState *state) {
+  SC_ReadyQueue *ready = state->data;
+  if (NULL == ready) {
+    return;
+  }
+
+  free(ready->entries);
+  free(ready);
+  state->data = NULL;
+}
+
+static size_t SC_QueuePolicy_PickNext(SC_PolicyState *state, SC_Time time) {
+  SC_ReadyQueue *ready = state->data;
+  if (ready->head == ready->tail) {
+    return SC_NO_SLOT;
+  }
+
+  if (!ready->sorted) {
+    SC_HeapEntry_Sort(&ready->entries[ready->head], ready->tail - ready->head);
+    ready->sorted = SC_TRUE;
+  }
+  return ready->entries[ready->head++].idx;
+}
+
+static SC_Time SC_Policy_RunToCompletion(SC_PolicyState *state, size_t slot,
+                                         SC_Time time) {
+  return SC_TIME_MAX;
+}
+
+// Like in Round Robin, a process that comes back goes last.
+static void SC_FifoPolicy_Admit(SC_PolicyState *state, size_t slot,
+                                SC_Time time, SC_Err err) {
+  SC_ReadyQueue_Push(state->data, (SC_HeapEntry){.key = 0, .idx = slot});
+}
+
+static void SC_ShortestFirstPolicy_Admit(SC_PolicyState *state, size_t slot,
+                                         SC_Time time, SC_Err err) {
+  SC_ReadyQueue *ready = state->data;
+  SC_HeapEntry entry = {.key = state->burst_time[slot], .idx = slot};
+  SC_ReadyQueue_Push(ready, entry);
+  ready->sorted = SC_FALSE;
+}
+
+static void SC_PriorityPolicy_Admit(SC_PolicyState *state, size_t slot,
+                                    SC_Time time, SC_Err err) {
+  SC_ReadyQueue *ready = state->data;
+  SC_HeapEntry entry = {.key = state->priority[slot], .idx = slot};
+  SC_ReadyQueue_Push(ready, entry);
+  ready->sorted = SC_FALSE;
+}
+
+// Runs the processes to completion in the order they arrive.
+static const SC_Policy SC_FIFO_POLICY = {
+    .name = "fifo",
+    .ignores_arrivals = SC_FALSE,
+    .init = SC_QueuePolicy_Init,
+    .deinit = SC_QueuePolicy_Deinit,
+    .admit = SC_FifoPolicy_Admit,
+    .pick_next = SC_QueuePolicy_PickNext,
+    .on_tick = SC_Policy_RunToCompletion,
+    .on_preempt = SC_FifoPolicy_Admit,
+    .preempts = NULL,
+};
+
+// Runs the shortest process to completion, without waiting for arrivals.
+static const SC_Policy SC_SHORTEST_FIRST_POLICY = {
+    .name = "sjf",
+    .ignores_arrivals = SC_TRUE,
+    .init = SC_QueuePolicy_Init,
+    .deinit = SC_QueuePolicy_Deinit,
+    .admit = SC_ShortestFirstPolicy_Admit,
+    .pick_next = SC_QueuePolicy_PickNext,
+    .on_tick = SC_Policy_RunToCompletion,
+    .on_preempt = SC_ShortestFirstPolicy_Admit,
+    .preempts = NULL,
+};
+
+// Runs the process with the lowest priority value to completion, without
+// waiting for arrivals.
+static const SC_Policy SC_PRIORITY_POLICY = {
+    .name = "priority",
+    .ignores_arrivals = SC_TRUE,
+    .init = SC_QueuePolicy_Init,
+    .deinit = SC_QueuePolicy_Deinit,
+    .admit = SC_PriorityPolicy_Admit,
+    .pick_next = SC_QueuePolicy_PickNext,
+    .on_tick = SC_Policy_RunToCompletion,
+    .on_preempt = SC_PriorityPolicy_Admit,
+    .preempts = NULL,
+};
+
+// Most policies a registry holds, and shared objects it loads.
+#define SC_MAX_POLICIES 32
+// What `SC_POLICY_PLUGIN` exports from a plugin.
+static const char *SC_POLICY_PLUGIN_VERSION = "sc_policy_abi_version";
+static const char *SC_POLICY_PLUGIN_POLICIES = "sc_policies";
+
+/**
+ * The policies registered at runtime, on top of the built-in algorithms.
+ *
+ * They can come from shared objects loaded with `SC_PolicyRegistry_Load`,
+ * which stay open until the registry is deinitialized. It's only read once
+ * they're registered, so simulations on several threads can share it.
+ */
+typedef struct {
+  const SC_Policy *policies[SC_MAX_POLICIES];
+  size_t count;
+  void *libraries[SC_MAX_POLICIES];
+  size_t library_count;
+  /** Why the last plugin failed to load. */
+  char load_error[256];
+} SC_PolicyRegistry;
+
+void SC_PolicyRegistry_Init(SC_PolicyRegistry *registry) {
+  registry->count = 0;
+  registry->library_count = 0;
+  registry->load_error[0] = 0;
+}
+
+void SC_PolicyRegistry_Deinit(SC_PolicyRegistry *registry) {
+  // The policies of a plugin live in it.
+  registry->count = 0;
+  for (size_t i = 0; i < registry->library_count; i++) {
+    dlclose(registry->libraries[i]);
+  }
+  registry->library_count = 0;
+}
+
+/**
+ * Returns the policy named `name`, or `NULL` if none is.
+ */
+const SC_Policy *SC_PolicyRegistry_Find(SC_PolicyRegistry *registry,
+                                        const char *name) {
+  for (size_t i = 0; i < registry->count; i++) {
+    if (strcmp(registry->policies[i]->name, name) == 0) {
+      return registry->policies[i];
+    }
+  }
+  return NULL;
+}
+
+/**
+ * Adds `policy`, which must outlive the registry.
+ *
+ * It fails with `INVALID_POLICY` if a callback is missing or its name is
+ * taken, and with `OUT_OF_BOUNDS` if the registry is full.
+ */
+void SC_PolicyRegistry_Register(SC_PolicyRegistry *registry,
+                                const SC_Policy *policy, SC_Err err) {
+  if (NULL == policy->name || NULL == policy->init ||
+      NULL == policy->deinit || NULL == policy->admit ||
+      NULL == policy->pick_next || NULL == policy->on_tick ||
+      NULL == policy->on_preempt ||
+      NULL != SC_PolicyRegistry_Find(registry, policy->name)) {
+    *err = INVALID_POLICY;
+    return;
+  }
+  if (registry->count == SC_MAX_POLICIES) {
+    *err = OUT_OF_BOUNDS;
+    return;
+  }
+
+  registry->policies[registry->count++] = policy;
+}
+
+/**
+ * Loads the shared object at `path` and registers the policies it exports
+ * with `SC_POLICY_PLUGIN`.
+ *
+ * Plugins include `policy.h` and build as shared objects, for example with
+ * `clang -shared -fPIC -o lcfs.so lcfs.c`. They're refused before any of
+ * their policies is touched if they were built for another
+ * `SC_POLICY_ABI_VERSION`. If it fails, nothing it registered is kept and
+ * `load_error` tells why.
+ */
+void SC_PolicyRegistry_Load(SC_PolicyRegistry *registry, const char *path,
+                            SC_Err err) {
+  if (registry->library_count == SC_MAX_POLICIES) {
+    snprintf(registry->load_error, sizeof(registry->load_error),
+             "Can't load more than %d plugins", SC_MAX_POLICIES);
+    *err = POLICY_LOAD_FAILED;
+    return;
+  }
+
+  void *library = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+  if (NULL == library) {
+    snprintf(registry->load_error, sizeof(registry->load_error), "%s",
+             dlerror());
+    *err = POLICY_LOAD_FAILED;
+    return;
+  }
+
+  const uint32_t *version = dlsym(library, SC_POLICY_PLUGIN_VERSION);
+  const SC_Policy *const *policies = dlsym(library, SC_POLICY_PLUGIN_POLICIES);
+  if (NULL == version || NULL == policies) {
+    snprintf(registry->load_error, sizeof(registry->load_error),
+             "`%s` doesn't export `%s` and `%s`", path,
+             SC_POLICY_PLUGIN_VERSION, SC_POLICY_PLUGIN_POLICIES);
+    *err = POLICY_LOAD_FAILED;
+  } else if (*version != SC_POLICY_ABI_VERSION) {
+    snprintf(registry->load_error, sizeof(registry->load_error),
+             "`%s` was built for policy ABI %" PRIu32 ", this is %d", path,
+             *version, SC_POLICY_ABI_VERSION);
+    *err = POLICY_LOAD_FAILED;
+  }
+  if (*err != NO_ERROR) {
+    dlclose(library);
+    return;
+  }
+
+  size_t count = registry->count;
+  for (size_t i = 0; NULL != policies[i]; i++) {
+    SC_PolicyRegistry_Register(registry, policies[i], err);
+    if (*err != NO_ERROR) {
+      snprintf(registry->load_error, sizeof(registry->load_error),
+               "`%s` failed to register its policies: %s", path,
+               SC_Err_ToString(err));
+      registry->count = count;
+      dlclose(library);
+      return;
+    }
+  }
+
+  registry->libraries[registry->library_count++] = library;
+}
+
+/**
+ * Computes the FIFO scheduling simulation
+ *
+ * @param processes *SC_ProcessTable The initial conditions of each
+ * process.
+ * @param sim *SC_Simulation The simulation state to fill with all the sim
+ * step data.
+ * @param err SC_Err The error parameter in case the steps can't be stored.
+ */
+void simulate_first_in_first_out(SC_ProcessTable *processes, SC_Simulation *sim,
+                                 SC_Err err) {
+  SC_PolicyEngine_RunBuiltIn(processes, sim, &SC_FIFO_POLICY, err);
+}
+
+void simulate_shortest_first(SC_ProcessTable *processes, SC_Simulation *sim,
+                             SC_Err err) {
+  SC_PolicyEngine_RunBuiltIn(processes, sim, &SC_SHORTEST_FIRST_POLICY, err);
+}
+
+/**
+ * Computes the Highest Response Ratio Next scheduling simulation.
+ *
+ * Like Shortest First it never preempts, but it picks the ready process with
+ * the highest response ratio, `(waiting + burst) / burst`. Short processes
+ * still go first, and the ratio of a long one grows while it waits, so it
+ * can't starve. Unlike Shortest First it waits for processes to arrive.
+ *
+ * Ratios change as time passes, so the ready processes play on a kinetic
+ * tournament tree that only compares them again when two ratios cross.
+ * Picking the next process costs O(log n) instead of a pass over every
+ * ready one. Ties are broken by the lowest `pid_idx`.
+ */
+void simulate_highest_response_ratio(SC_ProcessTable *processes,
+                                     SC_Simulation *sim, SC_Err err) {
+  size_t n = processes->count;
+
+  SC_HeapEntry *arrivals = malloc(sizeof(SC_HeapEntry) * (n > 0 ? n : 1));
+  SC_KineticTree ready = {0};
+
+  if (NULL == arrivals) {
+    *err = MALLOC_FAILED;
+  } else {
+    SC_KineticTree_Init(&ready, n, processes->arrival_time,
+                        processes->burst_time, err);
+  }
+  if (*err == NO_ERROR) {
+    SC_Simulation_Init(sim, processes, err);
+  }
+  if (*err != NO_ERROR) {
+    free(arrivals);
+    SC_KineticTree_Deinit(&ready);
+    return;
+  }
+
+  size_t completed = 0;
+  for (size_t i = 0; i < n; i++) {
+    arrivals[i] = (SC_HeapEntry){.key = processes->arrival_time[i], .idx = i};
+    if (processes->burst_time[i] == 0) {
+      completed++;
+    }
+  }
+  SC_HeapEntry_Sort(arrivals, n);
+
+  SC_Time time = 0;
+  size_t cursor = 0;
+
+  while (completed < n) {
+    SC_KineticTree_Advance(&ready, time);
+    for (; cursor < n && arrivals[cursor].key <= time; cursor++) {
+      size_t idx = arrivals[cursor].idx;
+      if (processes->burst_time[idx] > 0) {
+        SC_KineticTree_Insert(&ready, idx);
+      }
+    }
+
+    if (ready.length == 0) {
+      SC_Time next_arrival = arrivals[cursor].key;
+      SC_Simulation_Run(sim, SC_NO_PROCESS, time, next_arrival,
+                        SC_SEGMENT_IDLE, err);
+      if (*err != NO_ERROR) {
+        break;
+      }
+      time = next_arrival;
+      continue;
+    }
+
+    size_t running = SC_KineticTree_Top(&ready);
+    SC_KineticTree_Remove(&ready, running);
+    time = SC_Simulation_Switch(sim, processes->pid_idx[running], time, err);
+    SC_Time until = time + processes->burst_time[running];
+    SC_Simulation_Run(sim, processes->pid_idx[running], time, until,
+                      SC_SEGMENT_COMPLETED, err);
+    if (*err != NO_ERROR) {
+      break;
+    }
+
+    completed++;
+    time = until;
+  }
+
+  if (*err == NO_ERROR) {
+    SC_Simulation_Finish(sim, processes, err);
+  }
+
+  free(arrivals);
+  SC_KineticTree_Deinit(&ready);
+}
+
+/**
+ * Computes the Shortest Remaining Time scheduling simulation.
+ *
+ * The simulation only stops when something can change the decision: a
+ * process arriving or the running process completing. Time jumps straight
+ * from one of those events to the next, so the cost depends on the amount of
+ * processes instead of the total burst time.
+ *
+ * Arrivals are sorted once and admitted with a cursor into a min-heap keyed
+ * by `(remaining_time, pid_idx)`, so each decision costs O(log n). Ties are
+ * broken by the lowest `pid_idx`.
+ */
+void simulate_shortest_remaining(SC_ProcessTable *processes, SC_Simulation *sim,
+                                 SC_Err err) {
+  if (!processes || !sim)
+    return;
+
+  size_t n = processes->count;
+
+  SC_HeapEntry *arrivals = malloc(sizeof(SC_HeapEntry) * (n > 0 ? n : 1));
+  SC_Time *remaining_time = malloc(sizeof(SC_Time) * (n > 0 ? n : 1));
+
+  if (!remaining_time || !arrivals) {
+    free(arrivals);
+    free(remaining_time);
+    *err = MALLOC_FAILED;
+    return;
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    arrivals[i] = (SC_HeapEntry){.key = processes->arrival_time[i], .idx = i};
+  }
+
+  SC_HeapEntry_Sort(arrivals, n);
+
+  SC_Heap ready = {0};
+  SC_Heap_Init(&ready, n, err);
+  if (*err != NO_ERROR) {
+    free(arrivals);
+    free(remaining_time);
+    return;
+  }
+
+  SC_Simulation_Init(sim, processes, err);
+  if (*err != NO_ERROR) {
+    free(arrivals);
+    free(remaining_time);
+    SC_Heap_Deinit(&ready);
+    return;
+  }
+
+  size_t completed = 0;
+  for (size_t i = 0; i < n; i++) {
+    remaining_time[i] = processes->burst_time[i];
+    if (remaining_time[i] == 0) {
+      completed++;
+    }
+  }
+
+  SC_Time time = 0;
+  size_t cursor = 0;
+  size_t running = SC_NO_SLOT;
+
+  while (completed < n) {
+    for (; cursor < n && arrivals[cursor].key <= time; cursor++) {
+      size_t idx = arrivals[cursor].idx;
+      if (remaining_time[idx] == 0) {
+        continue;
+      }
+
+      SC_HeapEntry entry = {.key = remaining_time[idx], .idx = idx};
+      SC_Heap_Push(&ready, entry, err);
+      if (*err != NO_ERROR) {
+        break;
+      }
+    }
+    if (*err != NO_ERROR) {
+      break;
+    }
+
+    if (running != SC_NO_SLOT && ready.length > 0) {
+      SC_HeapEntry current = {.key = remaining_time[running], .idx = running};
+      if (SC_HeapEntry_Less(SC_Heap_Peek(&ready), current)) {
+        SC_Heap_Push(&ready, current, err);
+        if (*err != NO_ERROR) {
+          break;
+        }
+        running = SC_NO_SLOT;
+      }
+    }
+
+    SC_Time next_arrival =
+        cursor < n ? arrivals[cursor].key : SC_TIME_MAX;
+
+    if (running == SC_NO_SLOT) {
+      if (ready.length == 0) {
+        SC_Simulation_Run(sim, SC_NO_PROCESS, time, next_arrival,
+                          SC_SEGMENT_IDLE, err);
+        if (*err != NO_ERROR) {
+          break;
+        }
+        time = next_arrival;
+        continue;
+      }
+
+      running = SC_Heap_Pop(&ready).idx;
+    }
+
+    // Whatever arrives while the CPU switches may preempt the process
+    // before it progresses.
+    SC_Time switched =
+        SC_Simulation_Switch(sim, processes->pid_idx[running], time, err);
+    if (*err != NO_ERROR) {
+      break;
+    }
+    if (switched > time) {
+      time = switched;
+      continue;
+    }
+
+    // The process runs until it completes or someone else arrives.
+    SC_Time until = time + remaining_time[running];
+    SC_SegmentReason reason = SC_SEGMENT_COMPLETED;
+    if (next_arrival < until) {
+      until = next_arrival;
+      reason = SC_SEGMENT_PREEMPTED;
+    }
+
+    SC_Simulation_Run(sim, processes->pid_idx[running], time, until, reason,
+                      err);
+    if (*err != NO_ERROR) {
+      break;
+    }
+
+    remaining_time[running] -= until - time;
+    if (remaining_time[running] == 0) {
+      completed++;
+      running = SC_NO_SLOT;
+    }
+    time = until;
+  }
+
+  if (*err == NO_ERROR) {
+    SC_Simulation_Finish(sim, processes, err);
+  }
+
+  free(arrivals);
+  free(remaining_time);
+  SC_Heap_Deinit(&ready);
+}
+
+/**
+ * A FIFO ring buffer of process indices with a fixed capacity.
+ */
+typedef struct {
+  size_t *data;
+  size_t capacity;
+  size_t head;
+  size_t length;
+} SC_IndexQueue;
+
+void SC_IndexQueue_Init(SC_IndexQueue *queue, size_t capacity, SC_Err err) {
+  queue->data = malloc(sizeof(size_t) * (capacity > 0 ? capacity : 1));
+  if (NULL == queue->data) {
+    *err = MALLOC_FAILED;
+    return;
+  }
+  queue->capacity = capacity;
+  queue->head = 0;
+  queue->length = 0;
+}
+
+void SC_IndexQueue_Deinit(SC_IndexQueue *queue) {
+  free(queue->data);
+  queue->data = NULL;
+  queue->capacity = 0;
+  queue->head = 0;
+  queue->length = 0;
+}
+
+void SC_IndexQueue_Push(SC_IndexQueue *queue, size_t idx) {
+  if (queue->length == queue->capacity) {
+    SC_PANIC("Trying to push on a full queue of capacity %zu!",
+             queue->capacity);
+  }
+  size_t tail = queue->head + queue->length;
+  if (tail >= queue->capacity) {
+    tail -= queue->capacity;
+  }
+  queue->data[tail] = idx;
+  queue->length++;
+}
+
+size_t SC_IndexQueue_Pop(SC_IndexQueue *queue) {
+  if (queue->length == 0) {
+    SC_PANIC("Trying to pop an empty queue!");
+  }
+  size_t idx = queue->data[queue->head];
+  queue->head++;
+  if (queue->head == queue->capacity) {
+    queue->head = 0;
+  }
+  queue->length--;
+  return idx;
+}
+
+/**
+ * A point of a Round Robin run where another quantum can resume from.
+ *
+ * Until the first slice that expires its quantum every slice completes its
+ * process, so the ready queue holds the admitted processes that haven't been
+ * dispatched, in arrival order, and the whole state fits in a few counters.
+ */
+typedef struct {
+  SC_Time time;
+  /** Processes admitted, in arrival order. */
+  size_t cursor;
+  /** Processes dispatched. */
+  size_t dispatched;
+  size_t timeline_length;
+  size_t context_switches;
+  SC_Time overhead_time;
+  size_t last_pid;
+  /**
+   * Longest slice from the start until the one after this checkpoint,
+   * `SC_TIME_MAX` if that slice expired its quantum.
+   */
+  SC_Time max_slice;
+} SC_RoundRobinCheckpoint;
+
+/**
+ * Checkpoints saved by a Round Robin run, one before each slice until the
+ * first slice that expires its quantum.
+ *
+ * The schedules of two quanta are the same until the first slice where the
+ * running process needs more than the smaller quantum, so a run with another
+ * quantum can resume from the last checkpoint before that slice.
+ */
+typedef struct {
+  /** Quantum of the run that saved the checkpoints, 0 if there's none. */
+  int quantum;
+  /** Switch cost of that run, a run with another one starts from scratch. */
+  SC_SwitchCost switch_cost;
+  SC_Slice checkpoints;
+} SC_RoundRobinHistory;
+
+void SC_RoundRobinHistory_Init(SC_RoundRobinHistory *history, SC_Err err) {
+  history->quantum = 0;
+  history->switch_cost = (SC_SwitchCost){0};
+  SC_Slice_init(&history->checkpoints, sizeof(SC_RoundRobinCheckpoint),
+                SC_MIN_KEYFRAME_INTERVAL, err);
+}
+
+void SC_RoundRobinHistory_Deinit(SC_RoundRobinHistory *history) {
+  SC_Slice_deinit(&history->checkpoints);
+  history->quantum = 0;
+}
+
+// Forgets every checkpoint, the next run will start from scratch.
+void SC_RoundRobinHistory_Reset(SC_RoundRobinHistory *history) {
+  history->quantum = 0;
+  history->checkpoints.length = 0;
+}
+
+/**
+ * Returns the index of the checkpoint a run with `quantum` should resume from,
+ * or `SC_NO_SLOT` if it has to start from scratch.
+ */
+static size_t SC_RoundRobinHistory_Find(SC_RoundRobinHistory *history,
+                                        int quantum,
+                                        SC_SwitchCost *switch_cost) {
+  size_t length = history->checkpoints.length;
+  if (history->quantum <= 0 || length == 0) {
+    return SC_NO_SLOT;
+  }
+  if (history->switch_cost.switch_cost != switch_cost->switch_cost ||
+      history->switch_cost.cache_refill != switch_cost->cache_refill ||
+      history->switch_cost.cache_half_life != switch_cost->cache_half_life) {
+    return SC_NO_SLOT;
+  }
+
+  SC_RoundRobinCheckpoint *checkpoints = history->checkpoints.data;
+
+  // `max_slice` never decreases, look for the first slice that diverges.
+  size_t low = 0;
+  size_t high = length;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (checkpoints[mid].max_slice > (SC_Time)quantum) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    }
+  }
+
+  // Every saved slice is the same, only the last one needs to run again.
+  if (low == length) {
+    low = length - 1;
+  }
+
+  return checkpoints[low].time > 0 ? low : SC_NO_SLOT;
+}
+
+/**
+ * Enqueues every process from `arrivals[*cursor]` onwards that arrived up to
+ * `time`, advancing the cursor past them.
+ */
+static void SC_RoundRobin_Admit(SC_ProcessTable *processes,
+                                SC_HeapEntry *arrivals, size_t *cursor,
+                                SC_IndexQueue *queue, SC_Time time) {
+  size_t n = processes->count;
+  for (; *cursor < n && arrivals[*cursor].key <= time; (*cursor)++) {
+    if (processes->burst_time[arrivals[*cursor].idx] > 0) {
+      SC_IndexQueue_Push(queue, arrivals[*cursor].idx);
+    }
+  }
+}
+
+/**
+ * Computes the Round Robin scheduling simulation, resuming from `history` when
+ * it holds checkpoints of a previous run of `sim`.
+ *
+ * `history` must belong to `sim` and both to the same processes. New
+ * checkpoints are saved on it for the next run.
+ */
+void simulate_round_robin_incremental(SC_ProcessTable *processes,
+                                      SC_Simulation *sim,
+                                      SC_RoundRobinHistory *history,
+                                      int quantum, SC_Err err) {
+  if (!processes || !sim || quantum <= 0)
+    return;
+
+  size_t n = processes->count;
+
+  SC_HeapEntry *arrivals = malloc(sizeof(SC_HeapEntry) * (n > 0 ? n : 1));
+  SC_Time *remaining_time = malloc(sizeof(SC_Time) * (n > 0 ? n : 1));
+
+  if (!arrivals || !remaining_time) {
+    free(arrivals);
+    free(remaining_time);
+    *err = MALLOC_FAILED;
+    return;
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    arrivals[i] = (SC_HeapEntry){.key = processes->arrival_time[i], .idx = i};
+  }
+
+  SC_HeapEntry_Sort(arrivals, n);
+
+  SC_IndexQueue queue = {0};
+  SC_IndexQueue_Init(&queue, n, err);
+  if (*err != NO_ERROR) {
+    free(arrivals);
+    free(remaining_time);
+    return;
+  }
+
+  // Checkpoints only describe single CPU runs.
+  size_t resume = NULL == history || sim->cpu_count != 1
+                      ? SC_NO_SLOT
+                      : SC_RoundRobinHistory_Find(history, quantum,
+                                                  &sim->switch_cost);
+
+  size_t completed = 0;
+  size_t cursor = 0;
+  size_t dispatched = 0;
+  SC_Time time = 0;
+
+  if (resume == SC_NO_SLOT) {
+    if (NULL != history) {
+      SC_RoundRobinHistory_Reset(history);
+    }
+
+    SC_Simulation_Deinit(sim);
+    SC_Simulation_Init(sim, processes, err);
+    if (*err != NO_ERROR) {
+      free(arrivals);
+      free(remaining_time);
+      SC_IndexQueue_Deinit(&queue);
+      return;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+      remaining_time[i] = processes->burst_time[i];
+    }
+    SC_RoundRobin_Admit(processes, arrivals, &cursor, &queue, time);
+  } else {
+    SC_RoundRobinCheckpoint *checkpoint =
+        (SC_RoundRobinCheckpoint *)history->checkpoints.data + resume;
+    // The checkpoint is saved again when the run gets there.
+    history->checkpoints.length = resume;
+
+    time = checkpoint->time;
+    cursor = checkpoint->cursor;
+    dispatched = checkpoint->dispatched;
+    sim->context_switches = checkpoint->context_switches;
+    sim->overhead_time = checkpoint->overhead_time;
+    sim->last_pids[0] = checkpoint->last_pid;
+    if (sim->record_mode == SC_RECORD_STEPS) {
+      sim->timelines[0].length = checkpoint->timeline_length;
+      SC_StepStore_Truncate(&sim->steps, time);
+    }
+
+    // The first `dispatched` processes already completed, the rest of the
+    // admitted ones wait on the queue in arrival order.
+    size_t skipped = 0;
+    for (size_t j = 0; j < n; j++) {
+      size_t idx = arrivals[j].idx;
+      remaining_time[idx] = processes->burst_time[idx];
+      if (remaining_time[idx] == 0) {
+        continue;
+      }
+
+      if (j < cursor && skipped < dispatched) {
+        remaining_time[idx] = 0;
+        skipped++;
+        continue;
+      }
+
+      sim->completion[idx] = processes->arrival_time[idx] + remaining_time[idx];
+      sim->first_run[idx] = SC_TIME_MAX;
+      if (NULL != sim->left_at) {
+        sim->left_at[idx] = SC_TIME_MAX;
+      }
+      if (j < cursor) {
+        SC_IndexQueue_Push(&queue, idx);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    if (remaining_time[i] == 0) {
+      completed++;
+    }
+  }
+
+  SC_Bool saving_checkpoints = NULL != history;
+  SC_Time max_slice = 0;
+  if (saving_checkpoints && history->checkpoints.length > 0) {
+    SC_RoundRobinCheckpoint *checkpoints = history->checkpoints.data;
+    max_slice = checkpoints[history->checkpoints.length - 1].max_slice;
+  }
+
+  while (completed < n) {
+    if (queue.length == 0) {
+      // Nothing is ready, so the next process to run is the next arrival.
+      SC_Time next_arrival = arrivals[cursor].key;
+      SC_Simulation_Run(sim, SC_NO_PROCESS, time, next_arrival,
+                        SC_SEGMENT_IDLE, err);
+      if (*err != NO_ERROR) {
+        break;
+      }
+      time = next_arrival;
+      SC_RoundRobin_Admit(processes, arrivals, &cursor, &queue, time);
+      continue;
+    }
+
+    size_t current_process = SC_IndexQueue_Pop(&queue);
+    SC_Time slice = SC_Time_Min(quantum, remaining_time[current_process]);
+
+    if (saving_checkpoints) {
+      SC_Bool expires = remaining_time[current_process] > (SC_Time)quantum;
+      max_slice = expires ? SC_TIME_MAX : SC_Time_Max(max_slice, slice);
+      SC_RoundRobinCheckpoint checkpoint = {
+          .time = time,
+          .cursor = cursor,
+          .dispatched = dispatched,
+          .timeline_length =
+              NULL != sim->timelines ? sim->timelines[0].length : 0,
+          .context_switches = sim->context_switches,
+          .overhead_time = sim->overhead_time,
+          .last_pid = sim->last_pids[0],
+          .max_slice = max_slice,
+      };
+      SC_Slice_append(&history->checkpoints, &checkpoint, err);
+      if (*err != NO_ERROR) {
+        break;
+      }
+      // Checkpoints after this slice can't be shared with any other quantum.
+      saving_checkpoints = !expires;
+    }
+    dispatched++;
+
+    time = SC_Simulation_Switch(sim, processes->pid_idx[current_process], time,
+                                err);
+    SC_Time until = time + slice;
+
+    // Processes that arrived while this one was switching or running go
+    // first.
+    SC_RoundRobin_Admit(processes, arrivals, &cursor, &queue, until - 1);
+
+    remaining_time[current_process] -= slice;
+    SC_SegmentReason reason = SC_SEGMENT_COMPLETED;
+    if (remaining_time[current_process] == 0) {
+      completed++;
+    } else {
+      reason = SC_SEGMENT_QUANTUM_EXPIRED;
+      SC_IndexQueue_Push(&queue, current_process);
+    }
+
+    SC_Simulation_Run(sim, processes->pid_idx[current_process], time, until,
+                      reason, err);
+    if (*err != NO_ERROR) {
+      break;
+    }
+    time = until;
+    SC_RoundRobin_Admit(processes, arrivals, &cursor, &queue, time);
+  }
+
+  if (*err == NO_ERROR) {
+    SC_Simulation_Finish(sim, processes, err);
+  }
+
+  if (NULL != history) {
+    history->quantum = *err == NO_ERROR ? quantum : 0;
+    history->switch_cost = sim->switch_cost;
+  }
+
+  free(arrivals);
+  free(remaining_time);
+  SC_IndexQueue_Deinit(&queue);
+}
+
+/**
+ * Computes the Round Robin scheduling simulation.
+ *
+ * Time jumps from one slice to the next instead of advancing one unit at a
+ * time. A process that uses its whole quantum goes back to the queue after
+ * the processes that arrived while it ran, but before the ones that arrive
+ * right when its slice ends.
+ *
+ * Arrivals are sorted once and admitted with a cursor. Every process is at
+ * most once on the ready queue, so a ring buffer of `n` slots is enough.
+ */
+void simulate_round_robin(SC_ProcessTable *processes, SC_Simulation *sim,
+                          int quantum, SC_Err err) {
+  simulate_round_robin_incremental(processes, sim, NULL, quantum, err);
+}
+
+/**
+ * The metrics Round Robin gets with a given quantum.
+ */
+typedef struct {
+  int quantum;
+  float avg_waiting_time;
+  float avg_turnaround_time;
+  size_t context_switches;
+  float cpu_efficiency;
+} SC_QuantumSweepPoint;
+
+/**
+ * Simulates Round Robin with `point->quantum` and `switch_cost` recording only
+ * the metrics and stores them on `point`.
+ *
+ * The processes' waiting times are overwritten, so concurrent calls need
+ * their own copy of the processes.
+ */
+void SC_RoundRobin_Evaluate(SC_ProcessTable *processes,
+                            SC_SwitchCost *switch_cost,
+                            SC_QuantumSweepPoint *point, SC_Err err) {
+  SC_Simulation sim = {
+      .record_mode = SC_RECORD_METRICS,
+      .switch_cost = *switch_cost,
+  };
+  simulate_round_robin(processes, &sim, point->quantum, err);
+  point->avg_waiting_time = sim.avg_waiting_time;
+  point->avg_turnaround_time = sim.avg_turnaround_time;
+  point->context_switches = sim.context_switches;
+  point->cpu_efficiency = sim.cpu_efficiency;
+  SC_Simulation_Deinit(&sim);
+}
+
+/**
+ * Returns the index of the point with the lowest average waiting time.
+ *
+ * Ties go to the fewest context switches and then to the smallest quantum.
+ */
+size_t SC_QuantumSweep_Best(SC_QuantumSweepPoint *points, size_t count) {
+  size_t best = 0;
+  for (size_t i = 1; i < count; i++) {
+    SC_QuantumSweepPoint *a = &points[i];
+    SC_QuantumSweepPoint *b = &points[best];
+    if (a->avg_waiting_time != b->avg_waiting_time) {
+      if (a->avg_waiting_time < b->avg_waiting_time) {
+        best = i;
+      }
+    } else if (a->context_switches != b->context_switches) {
+      if (a->context_switches < b->context_switches) {
+        best = i;
+      }
+    } else if (a->quantum < b->quantum) {
+      best = i;
+    }
+  }
+
+  return best;
+}
+
+void simulate_priority(SC_ProcessTable *processes, SC_Simulation *sim,
+                       SC_Err err) {
+  SC_PolicyEngine_RunBuiltIn(processes, sim, &SC_PRIORITY_POLICY, err);
+}
+
+/**
+ * Computes the preemptive Priority scheduling simulation.
+ *
+ * The ready process with the lowest priority value always runs, a newcomer
+ * only preempts the running process if its priority is strictly better.
+ *
+ * Waiting processes age: every `aging_interval` time units spent on the ready
+ * queue their priority value drops by one until it reaches 0. Once a process
+ * gets the CPU it keeps its aged priority, and it goes back to its original
+ * priority if it's preempted. An `aging_interval` of 0 disables aging.
+ *
+ * The ready queue is an indexed heap keyed by `(priority, pid_idx)` and aging
+ * is driven by a second one keyed by the next time each process ages, so an
+ * aging event only touches the process that aged.
+ */
+void simulate_priority_preemptive(SC_ProcessTable *processes,
+                                  SC_Simulation *sim, SC_Time aging_interval,
+                                  SC_Err err) {
+  size_t n = processes->count;
+
+  SC_HeapEntry *arrivals = malloc(sizeof(SC_HeapEntry) * (n > 0 ? n : 1));
+  SC_Time *remaining_time = malloc(sizeof(SC_Time) * (n > 0 ? n : 1));
+  SC_Time *priority = malloc(sizeof(SC_Time) * (n > 0 ? n : 1));
+
+  if (!arrivals || !remaining_time || !priority) {
+    free(arrivals);
+    free(remaining_time);
+    free(priority);
+    *err = MALLOC_FAILED;
+    return;
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    arrivals[i] = (SC_HeapEntry){.key = processes->arrival_time[i], .idx = i};
+  }
+
+  SC_HeapEntry_Sort(arrivals, n);
+
+  SC_IndexedHeap ready = {0};
+  SC_IndexedHeap aging = {0};
+  SC_IndexedHeap_Init(&ready, n, err);
+  if (*err == NO_ERROR) {
+    SC_IndexedHeap_Init(&aging, n, err);
+  }
+  if (*err == NO_ERROR) {
+    SC_Simulation_Init(sim, processes, err);
+  }
+  if (*err != NO_ERROR) {
+    free(arrivals);
+    free(remaining_time);
+    free(priority);
+    SC_IndexedHeap_Deinit(&ready);
+    SC_IndexedHeap_Deinit(&aging);
+    return;
+  }
+
+  size_t completed = 0;
+  for (size_t i = 0; i < n; i++) {
+    remaining_time[i] = processes->burst_time[i];
+    priority[i] = processes->priority[i];
+    if (remaining_time[i] == 0) {
+      completed++;
+    }
+  }
+
+  SC_Time time = 0;
+  size_t cursor = 0;
+  size_t running = SC_NO_SLOT;
+
+  while (completed < n) {
+    for (; cursor < n && arrivals[cursor].key <= time; cursor++) {
+      size_t idx = arrivals[cursor].idx;
+      if (remaining_time[idx] == 0) {
+        continue;
+      }
+
+      SC_HeapEntry entry = {.key = priority[idx], .idx = idx};
+      SC_IndexedHeap_Push(&ready, entry);
+      if (aging_interval > 0 && priority[idx] > 0) {
+        SC_HeapEntry next_aging = {.key = time + aging_interval, .idx = idx};
+        SC_IndexedHeap_Push(&aging, next_aging);
+      }
+    }
+
+    while (aging.length > 0 && SC_IndexedHeap_Peek(&aging).key <= time) {
+      SC_HeapEntry aged = SC_IndexedHeap_Pop(&aging);
+      priority[aged.idx]--;
+      SC_IndexedHeap_DecreaseKey(&ready, aged.idx, priority[aged.idx]);
+      if (priority[aged.idx] > 0) {
+        aged.key += aging_interval;
+        SC_IndexedHeap_Push(&aging, aged);
+      }
+    }
+
+    if (running != SC_NO_SLOT && ready.length > 0 &&
+        SC_IndexedHeap_Peek(&ready).key < priority[running]) {
+      priority[running] = processes->priority[running];
+      SC_HeapEntry entry = {.key = priority[running], .idx = running};
+      SC_IndexedHeap_Push(&ready, entry);
+      if (aging_interval > 0 && priority[running] > 0) {
+        SC_HeapEntry next_aging = {.key = time + aging_interval,
+                                   .idx = running};
+        SC_IndexedHeap_Push(&aging, next_aging);
+      }
+      running = SC_NO_SLOT;
+    }
+
+    SC_Time next_event = cursor < n ? arrivals[cursor].key : SC_TIME_MAX;
+    if (aging.length > 0) {
+      next_event = SC_Time_Min(next_event, SC_IndexedHeap_Peek(&aging).key);
+    }
+
+    if (running == SC_NO_SLOT) {
+      if (ready.length == 0) {
+        SC_Simulation_Run(sim, SC_NO_PROCESS, time, next_event,
+                          SC_SEGMENT_IDLE, err);
+        if (*err != NO_ERROR) {
+          break;
+        }
+        time = next_event;
+        continue;
+      }
+
+      running = SC_IndexedHeap_Pop(&ready).idx;
+      if (SC_IndexedHeap_Contains(&aging, running)) {
+        SC_IndexedHeap_Remove(&aging, running);
+      }
+      continue;
+    }
+
+    // Arrivals and aging during the switch may still preempt the process.
+    SC_Time switched =
+        SC_Simulation_Switch(sim, processes->pid_idx[running], time, err);
+    if (*err != NO_ERROR) {
+      break;
+    }
+    if (switched > time) {
+      time = switched;
+      continue;
+    }
+
+    // The process runs until it completes or something may preempt it.
+    SC_Time until = time + remaining_time[running];
+    SC_SegmentReason reason = SC_SEGMENT_COMPLETED;
+    if (next_event < until) {
+      until = next_event;
+      reason = SC_SEGMENT_PREEMPTED;
+    }
+
+    SC_Simulation_Run(sim, processes->pid_idx[running], time, until, reason,
+                      err);
+    if (*err != NO_ERROR) {
+      break;
+    }
+
+    remaining_time[running] -= until - time;
+    if (remaining_time[running] == 0) {
+      completed++;
+      running = SC_NO_SLOT;
+    }
+    time = until;
+  }
+
+  if (*err == NO_ERROR) {
+    SC_Simulation_Finish(sim, processes, err);
+  }
+
+  free(arrivals);
+  free(remaining_time);
+  free(priority);
+  SC_IndexedHeap_Deinit(&ready);
+  SC_IndexedHeap_Deinit(&aging);
+}
+
+// Most levels a Multi-Level Feedback Queue can have, one bit of the bitmap
+// per level.
+#define SC_MLFQ_MAX_LEVELS 64
+
+/**
+ * How a Multi-Level Feedback Queue runs.
+ *
+ * Level 0 runs first. A process that uses all the time of its level is
+ * demoted to the next one, so interactive processes stay on top.
+ */
+typedef struct {
+  size_t level_count;
+  /** Time each level lets a process run before demoting it. */
+  SC_Time quanta[SC_MLFQ_MAX_LEVELS];
+  /**
+   * Every `boost_interval` time units every process goes back to level 0, so
+   * demoted processes never starve. 0 disables boosts.
+   */
+  SC_Time boost_interval;
+} SC_MlfqConfig;
+
+/**
+ * A queue with `level_count` levels whose quanta double from `base_quantum`.
+ */
+SC_MlfqConfig SC_MlfqConfig_Doubling(size_t level_count, SC_Time base_quantum,
+                                     SC_Time boost_interval) {
+  SC_MlfqConfig config = {.boost_interval = boost_interval};
+  config.level_count =
+      level_count < SC_MLFQ_MAX_LEVELS ? level_count : SC_MLFQ_MAX_LEVELS;
+  for (size_t level = 0; level < config.level_count; level++) {
+    config.quanta[level] = base_quantum << level;
+  }
+  return config;
+}
+
+/**
+ * Sets one level per quantum of a comma separated `list`, like `2,4,8`.
+ *
+ * Fails with `INVALID_STRING` if a quantum isn't a positive number or there
+ * are more than `SC_MLFQ_MAX_LEVELS`.
+ */
+void SC_MlfqConfig_ParseQuanta(SC_MlfqConfig *config, const char *list,
+                               SC_Err err) {
+  size_t level_count = 0;
+  SC_Time quanta[SC_MLFQ_MAX_LEVELS];
+  const char *current = list;
+  while (*current != 0) {
+    char *end = NULL;
+    unsigned long long quantum = strtoull(current, &end, 10);
+    if (end == current || quantum == 0 || level_count == SC_MLFQ_MAX_LEVELS ||
+        (*end != ',' && *end != 0)) {
+      *err = INVALID_STRING;
+      return;
+    }
+
+    quanta[level_count++] = quantum;
+    current = *end == ',' ? end + 1 : end;
+  }
+
+  if (level_count == 0) {
+    *err = INVALID_STRING;
+    return;
+  }
+  config->level_count = level_count;
+  memcpy(config->quanta, quanta, sizeof(SC_Time) * level_count);
+}
+
+/**
+ * The ready queues of a Multi-Level Feedback Queue.
+ *
+ * Each level is a FIFO linked through `next`, and bit `i` of `bitmap` is set
+ * while level `i` has processes, so the highest non-empty level is found
+ * with a single find-first-set no matter how many processes wait.
+ */
+typedef struct {
+  uint64_t bitmap;
+  size_t heads[SC_MLFQ_MAX_LEVELS];
+  size_t tails[SC_MLFQ_MAX_LEVELS];
+  /** The process after each slot on its level, or `SC_NO_SLOT`. */
+  size_t *next;
+} SC_MlfqQueues;
+
+static void SC_MlfqQueues_Push(SC_MlfqQueues *queues, size_t level,
+                               size_t slot) {
+  queues->next[slot] = SC_NO_SLOT;
+  if (queues->bitmap & (UINT64_C(1) << level)) {
+    queues->next[queues->tails[level]] = slot;
+  } else {
+    queues->heads[level] = slot;
+    queues->bitmap |= UINT64_C(1) << level;
+  }
+  queues->tails[level] = slot;
+}
+
+// The highest level with processes, `queues->bitmap` must not be 0.
+static size_t SC_MlfqQueues_TopLevel(SC_MlfqQueues *queues) {
+  return __builtin_ctzll(queues->bitmap);
+}
+
+static size_t SC_MlfqQueues_Pop(SC_MlfqQueues *queues, size_t level) {
+  size_t slot = queues->heads[level];
+  queues->heads[level] = queues->next[slot];
+  if (queues->heads[level] == SC_NO_SLOT) {
+    queues->bitmap &= ~(UINT64_C(1) << level);
+  }
+  return slot;
+}
+
+// Moves every level after the first to the end of level 0, in order.
+static void SC_MlfqQueues_Boost(SC_MlfqQueues *queues) {
+  uint64_t lower = queues->bitmap & ~UINT64_C(1);
+  while (lower != 0) {
+    size_t level = __builtin_ctzll(lower);
+    lower &= lower - 1;
+
+    if (queues->bitmap & 1) {
+      queues->next[queues->tails[0]] = queues->heads[level];
+    } else {
+      queues->heads[0] = queues->heads[level];
+    }
+    queues->tails[0] = queues->tails[level];
+    queues->bitmap |= 1;
+  }
+  queues->bitmap &= 1;
+}
+
+/**
+ * Computes the Multi-Level Feedback Queue scheduling simulation.
+ *
+ * Arriving processes enter level 0. The first process of the highest
+ * non-empty level runs, and it's preempted as soon as a process enters a
+ * higher level. Time used on a level adds up across preemptions, once it
+ * reaches the level's quantum the process is demoted to the next level and
+ * goes to the end of it. The last level works like Round Robin.
+ *
+ * Boosts splice every level onto level 0 in O(levels). Processes that were
+ * waiting lazily forget the time they used on their level the next time
+ * they run, so a boost never walks the processes.
+ */
+void simulate_multilevel_feedback(SC_ProcessTable *processes,
+                                  SC_Simulation *sim, SC_MlfqConfig *config,
+                                  SC_Err err) {
+  size_t n = processes->count;
+  size_t level_count = config->level_count;
+  if (level_count == 0 || level_count > SC_MLFQ_MAX_LEVELS) {
+    SC_PANIC("An MLFQ needs from 1 to %d levels, not %zu!",
+             SC_MLFQ_MAX_LEVELS, level_count);
+  }
+
+  SC_HeapEntry *arrivals = malloc(sizeof(SC_HeapEntry) * (n > 0 ? n : 1));
+  SC_Time *remaining_time = malloc(sizeof(SC_Time) * (n > 0 ? n : 1));
+  // Time each process used on its level, valid while `boosts` matches.
+  SC_Time *used = malloc(sizeof(SC_Time) * (n > 0 ? n : 1));
+  size_t *boosts = malloc(sizeof(size_t) * (n > 0 ? n : 1));
+  SC_MlfqQueues queues = {0};
+  queues.next = malloc(sizeof(size_t) * (n > 0 ? n : 1));
+
+  if (!arrivals || !remaining_time || !used || !boosts || !queues.next) {
+    *err = MALLOC_FAILED;
+  } else {
+    SC_Simulation_Init(sim, processes, err);
+  }
+  if (*err != NO_ERROR) {
+    free(arrivals);
+    free(remaining_time);
+    free(used);
+    free(boosts);
+    free(queues.next);
+    return;
+  }
+
+  size_t completed = 0;
+  for (size_t i = 0; i < n; i++) {
+    arrivals[i] = (SC_HeapEntry){.key = processes->arrival_time[i], .idx = i};
+    remaining_time[i] = processes->burst_time[i];
+    if (remaining_time[i] == 0) {
+      completed++;
+    }
+  }
+  SC_HeapEntry_Sort(arrivals, n);
+
+  SC_Time boost_interval = config->boost_interval;
+  SC_Time next_boost = boost_interval > 0 ? boost_interval : SC_TIME_MAX;
+  size_t boost_count = 0;
+
+  SC_Time time = 0;
+  size_t cursor = 0;
+  size_t running = SC_NO_SLOT;
+  size_t running_level = 0;
+
+  while (completed < n) {
+    for (; cursor < n && arrivals[cursor].key <= time; cursor++) {
+      size_t idx = arrivals[cursor].idx;
+      if (remaining_time[idx] == 0) {
+        continue;
+      }
+
+      used[idx] = 0;
+      boosts[idx] = boost_count;
+      SC_MlfqQueues_Push(&queues, 0, idx);
+    }
+
+    if (time >= next_boost) {
+      SC_MlfqQueues_Boost(&queues);
+      boost_count++;
+      next_boost = (time / boost_interval + 1) * boost_interval;
+      if (running != SC_NO_SLOT) {
+        running_level = 0;
+        used[running] = 0;
+        boosts[running] = boost_count;
+      }
+    }
+
+    if (running != SC_NO_SLOT && queues.bitmap != 0 &&
+        SC_MlfqQueues_TopLevel(&queues) < running_level) {
+      SC_MlfqQueues_Push(&queues, running_level, running);
+      running = SC_NO_SLOT;
+    }
+
+    SC_Time next_event = cursor < n ? arrivals[cursor].key : SC_TIME_MAX;
+    if (running == SC_NO_SLOT && queues.bitmap == 0) {
+      // Boosts can't change anything while there's nothing to run.
+      SC_Simulation_Run(sim, SC_NO_PROCESS, time, next_event, SC_SEGMENT_IDLE,
+                        err);
+      if (*err != NO_ERROR) {
+        break;
+      }
+      time = next_event;
+      continue;
+    }
+
+    if (running == SC_NO_SLOT) {
+      running_level = SC_MlfqQueues_TopLevel(&queues);
+      running = SC_MlfqQueues_Pop(&queues, running_level);
+      if (boosts[running] != boost_count) {
+        used[running] = 0;
+        boosts[running] = boost_count;
+      }
+    }
+
+    // An arrival or a boost during the switch may still preempt it.
+    SC_Time switched =
+        SC_Simulation_Switch(sim, processes->pid_idx[running], time, err);
+    if (*err != NO_ERROR) {
+      break;
+    }
+    if (switched > time) {
+      time = switched;
+      continue;
+    }
+
+    // The process runs until it completes, uses its level's quantum or
+    // something may preempt it.
+    next_event = SC_Time_Min(next_event, next_boost);
+    SC_Time quantum = config->quanta[running_level];
+    SC_Time left = quantum > used[running] ? quantum - used[running] : 0;
+    SC_Time until = time + SC_Time_Min(remaining_time[running], left);
+    SC_SegmentReason reason = remaining_time[running] <= left
+                                  ? SC_SEGMENT_COMPLETED
+                                  : SC_SEGMENT_QUANTUM_EXPIRED;
+    if (next_event < until) {
+      until = next_event;
+      reason = SC_SEGMENT_PREEMPTED;
+    }
+
+    SC_Simulation_Run(sim, processes->pid_idx[running], time, until, reason,
+                      err);
+    if (*err != NO_ERROR) {
+      break;
+    }
+
+    remaining_time[running] -= until - time;
+    used[running] += until - time;
+    time = until;
+
+    if (reason == SC_SEGMENT_COMPLETED) {
+      completed++;
+      running = SC_NO_SLOT;
+    } else if (reason == SC_SEGMENT_QUANTUM_EXPIRED) {
+      size_t level =
+          running_level + 1 < level_count ? running_level + 1 : running_level;
+      used[running] = 0;
+      SC_MlfqQueues_Push(&queues, level, running);
+      running = SC_NO_SLOT;
+    }
+  }
+
+  if (*err == NO_ERROR) {
+    SC_Simulation_Finish(sim, processes, err);
+  }
+
+  free(arrivals);
+  free(remaining_time);
+  free(used);
+  free(boosts);
+  free(queues.next);
+}
+
+/**
+ * How the Completely Fair Scheduler splits the CPU.
+ */
+typedef struct {
+  /**
+   * Period in which every ready process should run once, split between them
+   * by weight.
+   */
+  SC_Time target_latency;
+  /**
+   * Shortest slice a process gets, the period grows once there are too many
+   * processes to give each one this much. It also keeps newcomers from
+   * preempting a process that has barely run.
+   */
+  SC_Time min_granularity;
+} SC_CfsConfig;
+
+SC_CfsConfig SC_CfsConfig_Default(void) {
+  return (SC_CfsConfig){.target_latency = 24, .min_granularity = 3};
+}
+
+// Weight of each nice value from 0 to 19, every step is about 10% less CPU.
+static const SC_Time SC_CFS_WEIGHTS[] = {
+    1024, 820, 655, 526, 423, 335, 272, 215, 172, 137,
+    110,  87,  70,  56,  45,  36,  29,  23,  18,  15,
+};
+static const size_t SC_CFS_NICE_COUNT =
+    sizeof(SC_CFS_WEIGHTS) / sizeof(SC_CFS_WEIGHTS[0]);
+// Virtual runtime of a nice 0 process per time unit. Time units are coarse,
+// so it's scaled up to keep the heavier weights from rounding to the same
+// virtual runtime.
+static const SC_Time SC_CFS_NICE_0_VRUNTIME = 1024 * 1024;
+
+// The weight of a process, priorities over 19 all get the lightest weight.
+static SC_Time SC_Cfs_Weight(uint priority) {
+  return SC_CFS_WEIGHTS[priority < SC_CFS_NICE_COUNT ? priority
+                                                     : SC_CFS_NICE_COUNT - 1];
+}
+
+static SC_Time SC_Cfs_Vruntime(SC_Time delta, SC_Time weight) {
+  return delta * SC_CFS_NICE_0_VRUNTIME / weight;
+}
+
+/**
+ * Computes the Completely Fair Scheduler simulation.
+ *
+ * The priority of a process is its nice value: 0 is the heaviest weight and
+ * each step up gets about 10% less CPU. Running adds to the virtual runtime
+ * of a process in inverse proportion to its weight, and the ready process
+ * with the lowest virtual runtime always runs next.
+ *
+ * A process runs for its share of the period, `target_latency` or
+ * `min_granularity` per ready process if that's longer, weighted by its
+ * weight over the total. Newcomers start at the lowest virtual runtime seen
+ * so far and preempt the running process once it's ahead of them by more
+ * than `min_granularity` of their time.
+ *
+ * Ready processes wait on a red-black tree keyed by virtual runtime, so
+ * enqueuing and picking the next process cost O(log n).
+ */
+void simulate_completely_fair(SC_ProcessTable *processes, SC_Simulation *sim,
+                              SC_CfsConfig *config, SC_Err err) {
+  size_t n = processes->count;
+  if (config->target_latency == 0 || config->min_granularity == 0) {
+    SC_PANIC("The CFS target latency and minimum granularity must be "
+             "positive!");
+  }
+
+  SC_HeapEntry *arrivals = malloc(sizeof(SC_HeapEntry) * (n > 0 ? n : 1));
+  SC_Time *remaining_time = malloc(sizeof(SC_Time) * (n > 0 ? n : 1));
+  SC_Time *weight = malloc(sizeof(SC_Time) * (n > 0 ? n : 1));
+  SC_Time *vruntime = calloc(n > 0 ? n : 1, sizeof(SC_Time));
+  SC_RbTree ready = {0};
+
+  if (!arrivals || !remaining_time || !weight || !vruntime) {
+    *err = MALLOC_FAILED;
+  } else {
+    SC_RbTree_Init(&ready, n, vruntime, err);
+  }
+  if (*err == NO_ERROR) {
+    SC_Simulation_Init(sim, processes, err);
+  }
+  if (*err != NO_ERROR) {
+    free(arrivals);
+    free(remaining_time);
+    free(weight);
+    free(vruntime);
+    SC_RbTree_Deinit(&ready);
+    return;
+  }
+
+  size_t completed = 0;
+  for (size_t i = 0; i < n; i++) {
+    arrivals[i] = (SC_HeapEntry){.key = processes->arrival_time[i], .idx = i};
+    remaining_time[i] = processes->burst_time[i];
+    weight[i] = SC_Cfs_Weight(processes->priority[i]);
+    if (remaining_time[i] == 0) {
+      completed++;
+    }
+  }
+  SC_HeapEntry_Sort(arrivals, n);
+
+  SC_Time time = 0;
+  size_t cursor = 0;
+  size_t running = SC_NO_SLOT;
+  SC_Time slice_end = 0;
+  // Weight of the ready and running processes.
+  SC_Time total_weight = 0;
+  // Never goes back, so newcomers can't starve processes that already ran.
+  SC_Time min_vruntime = 0;
+
+  while (completed < n) {
+    SC_Bool arrived = SC_FALSE;
+    for (; cursor < n && arrivals[cursor].key <= time; cursor++) {
+      size_t idx = arrivals[cursor].idx;
+      if (remaining_time[idx] == 0) {
+        continue;
+      }
+
+      vruntime[idx] = min_vruntime;
+      SC_RbTree_Insert(&ready, idx);
+      total_weight += weight[idx];
+      arrived = SC_TRUE;
+    }
+
+    if (arrived && running != SC_NO_SLOT) {
+      size_t first = ready.leftmost;
+      SC_Time granularity =
+          SC_Cfs_Vruntime(config->min_granularity, weight[first]);
+      if (vruntime[running] > vruntime[first] + granularity) {
+        SC_RbTree_Insert(&ready, running);
+        running = SC_NO_SLOT;
+      }
+    }
+
+    SC_Time next_event = cursor < n ? arrivals[cursor].key : SC_TIME_MAX;
+    if (running == SC_NO_SLOT && ready.length == 0) {
+      SC_Simulation_Run(sim, SC_NO_PROCESS, time, next_event, SC_SEGMENT_IDLE,
+                        err);
+      if (*err != NO_ERROR) {
+        break;
+      }
+      time = next_event;
+      continue;
+    }
+
+    if (running == SC_NO_SLOT) {
+      size_t nr_running = ready.length;
+      SC_Time period = config->target_latency;
+      if (nr_running * config->min_granularity > period) {
+        period = nr_running * config->min_granularity;
+      }
+
+      running = ready.leftmost;
+      SC_RbTree_Remove(&ready, running);
+      SC_Time slice = period * weight[running] / total_weight;
+      SC_Time switched =
+          SC_Simulation_Switch(sim, processes->pid_idx[running], time, err);
+      if (*err != NO_ERROR) {
+        break;
+      }
+      // The slice starts once the switch ends, and newcomers may take the
+      // CPU before it does.
+      slice_end = switched + (slice > 0 ? slice : 1);
+      if (switched > time) {
+        time = switched;
+        continue;
+      }
+    }
+
+    SC_Time until = time + remaining_time[running];
+    SC_SegmentReason reason = SC_SEGMENT_COMPLETED;
+    if (slice_end < until) {
+      until = slice_end;
+      reason = SC_SEGMENT_QUANTUM_EXPIRED;
+    }
+    if (next_event < until) {
+      until = next_event;
+      reason = SC_SEGMENT_PREEMPTED;
+    }
+
+    SC_Simulation_Run(sim, processes->pid_idx[running], time, until, reason,
+                      err);
+    if (*err != NO_ERROR) {
+      break;
+    }
+
+    remaining_time[running] -= until - time;
+    vruntime[running] += SC_Cfs_Vruntime(until - time, weight[running]);
+    time = until;
+
+    SC_Time lowest = vruntime[running];
+    if (ready.length > 0 && vruntime[ready.leftmost] < lowest) {
+      lowest = vruntime[ready.leftmost];
+    }
+    min_vruntime = lowest > min_vruntime ? lowest : min_vruntime;
+
+    if (reason == SC_SEGMENT_COMPLETED) {
+      completed++;
+      total_weight -= weight[running];
+      running = SC_NO_SLOT;
+    } else if (reason == SC_SEGMENT_QUANTUM_EXPIRED) {
+      SC_RbTree_Insert(&ready, running);
+      running = SC_NO_SLOT;
+    }
+  }
+
+  if (*err == NO_ERROR) {
+    SC_Simulation_Finish(sim, processes, err);
+  }
+
+  free(arrivals);
+  free(remaining_time);
+  free(weight);
+  free(vruntime);
+  SC_RbTree_Deinit(&ready);
+}
+
+// Tickets of a process on lottery and stride scheduling, the same weights the
+// CFS gives each priority so the three split the CPU alike.
+static SC_Time SC_Share_Tickets(uint priority) {
+  return SC_Cfs_Weight(priority);
+}
+
+/**
+ * Computes the lottery scheduling simulation.
+ *
+ * Every ready process holds as many tickets as its CFS weight. Each quantum
+ * a random ticket is drawn and its holder runs, so on average a process gets
+ * CPU in proportion to its tickets. Newcomers join the next draw. The same
+ * `seed` always draws the same tickets.
+ *
+ * Tickets live on a Fenwick tree, so a draw costs O(log n) no matter how many
+ * processes are ready.
+ */
+void simulate_lottery(SC_ProcessTable *processes, SC_Simulation *sim,
+                      SC_Time quantum, uint64_t seed, SC_Err err) {
+  size_t n = processes->count;
+  if (quantum == 0) {
+    SC_PANIC("The lottery quantum must be positive!");
+  }
+
+  SC_HeapEntry *arrivals = malloc(sizeof(SC_HeapEntry) * (n > 0 ? n : 1));
+  SC_Time *remaining_time = malloc(sizeof(SC_Time) * (n > 0 ? n : 1));
+  SC_FenwickTree tickets = {0};
+
+  if (!arrivals || !remaining_time) {
+    *err = MALLOC_FAILED;
+  } else {
+    SC_FenwickTree_Init(&tickets, n, err);
+  }
+  if (*err == NO_ERROR) {
+    SC_Simulation_Init(sim, processes, err);
+  }
+  if (*err != NO_ERROR) {
+    free(arrivals);
+    free(remaining_time);
+    SC_FenwickTree_Deinit(&tickets);
+    return;
+  }
+
+  size_t completed = 0;
+  for (size_t i = 0; i < n; i++) {
+    arrivals[i] = (SC_HeapEntry){.key = processes->arrival_time[i], .idx = i};
+    remaining_time[i] = processes->burst_time[i];
+    if (remaining_time[i] == 0) {
+      completed++;
+    }
+  }
+  SC_HeapEntry_Sort(arrivals, n);
+
+  SC_Random random;
+  SC_Random_Init(&random, seed);
+  SC_Time time = 0;
+  size_t cursor = 0;
+
+  while (completed < n) {
+    for (; cursor < n && arrivals[cursor].key <= time; cursor++) {
+      size_t idx = arrivals[cursor].idx;
+      if (remaining_time[idx] > 0) {
+        SC_FenwickTree_Add(&tickets, idx,
+                           SC_Share_Tickets(processes->priority[idx]));
+      }
+    }
+
+    if (tickets.total == 0) {
+      SC_Time next_arrival = arrivals[cursor].key;
+      SC_Simulation_Run(sim, SC_NO_PROCESS, time, next_arrival,
+                        SC_SEGMENT_IDLE, err);
+      if (*err != NO_ERROR) {
+        break;
+      }
+      time = next_arrival;
+      continue;
+    }
+
+    size_t winner =
+        SC_FenwickTree_Find(&tickets, SC_Random_Below(&random, tickets.total));
+    time = SC_Simulation_Switch(sim, processes->pid_idx[winner], time, err);
+    if (*err != NO_ERROR) {
+      break;
+    }
+    SC_Time until = time + quantum;
+    SC_SegmentReason reason = SC_SEGMENT_QUANTUM_EXPIRED;
+    if (remaining_time[winner] <= quantum) {
+      until = time + remaining_time[winner];
+      reason = SC_SEGMENT_COMPLETED;
+    }
+
+    SC_Simulation_Run(sim, processes->pid_idx[winner], time, until, reason,
+                      err);
+    if (*err != NO_ERROR) {
+      break;
+    }
+
+    remaining_time[winner] -= until - time;
+    time = until;
+    if (reason == SC_SEGMENT_COMPLETED) {
+      SC_FenwickTree_Subtract(&tickets, winner,
+                              SC_Share_Tickets(processes->priority[winner]));
+      completed++;
+    }
+  }
+
+  if (*err == NO_ERROR) {
+    SC_Simulation_Finish(sim, processes, err);
+  }
+
+  free(arrivals);
+  free(remaining_time);
+  SC_FenwickTree_Deinit(&tickets);
+}
+
+// Pass a process with a single ticket advances per quantum. It's big so the
+// strides keep the ratio of the tickets after rounding.
+static const SC_Time SC_STRIDE_ONE = 1 << 20;
+
+/**
+ * Computes the stride scheduling simulation, the deterministic version of
+ * lottery scheduling.
+ *
+ * Every process holds as many tickets as its CFS weight, and advances its
+ * pass by `SC_STRIDE_ONE / tickets` each quantum it runs. The ready process
+ * with the lowest pass runs next, so every process gets CPU in proportion to
+ * its tickets, within about a quantum instead of drifting like a lottery.
+ * Newcomers start at the pass of the last process that ran and join once the
+ * current quantum ends.
+ *
+ * Passes live on a min-heap, so picking the next process costs O(log n).
+ */
+void simulate_stride(SC_ProcessTable *processes, SC_Simulation *sim,
+                     SC_Time quantum, SC_Err err) {
+  size_t n = processes->count;
+  if (quantum == 0) {
+    SC_PANIC("The stride quantum must be positive!");
+  }
+
+  SC_HeapEntry *arrivals = malloc(sizeof(SC_HeapEntry) * (n > 0 ? n : 1));
+  SC_Time *remaining_time = malloc(sizeof(SC_Time) * (n > 0 ? n : 1));
+  SC_Heap ready = {0};
+
+  if (!arrivals || !remaining_time) {
+    *err = MALLOC_FAILED;
+  } else {
+    SC_Heap_Init(&ready, n, err);
+  }
+  if (*err == NO_ERROR) {
+    SC_Simulation_Init(sim, processes, err);
+  }
+  if (*err != NO_ERROR) {
+    free(arrivals);
+    free(remaining_time);
+    SC_Heap_Deinit(&ready);
+    return;
+  }
+
+  size_t completed = 0;
+  for (size_t i = 0; i < n; i++) {
+    arrivals[i] = (SC_HeapEntry){.key = processes->arrival_time[i], .idx = i};
+    remaining_time[i] = processes->burst_time[i];
+    if (remaining_time[i] == 0) {
+      completed++;
+    }
+  }
+  SC_HeapEntry_Sort(arrivals, n);
+
+  SC_Time time = 0;
+  size_t cursor = 0;
+  // The pass of the last process that ran, it never goes back.
+  SC_Time global_pass = 0;
+
+  while (completed < n) {
+    for (; cursor < n && arrivals[cursor].key <= time; cursor++) {
+      size_t idx = arrivals[cursor].idx;
+      if (remaining_time[idx] > 0) {
+        // The heap has room for every process, so pushing can't fail.
+        SC_Heap_Push(&ready, (SC_HeapEntry){.key = global_pass, .idx = idx},
+                     err);
+      }
+    }
+
+    if (ready.length == 0) {
+      SC_Time next_arrival = arrivals[cursor].key;
+      SC_Simulation_Run(sim, SC_NO_PROCESS, time, next_arrival,
+                        SC_SEGMENT_IDLE, err);
+      if (*err != NO_ERROR) {
+        break;
+      }
+      time = next_arrival;
+      continue;
+    }
+
+    SC_HeapEntry entry = SC_Heap_Pop(&ready);
+    size_t running = entry.idx;
+    global_pass = entry.key;
+
+    time = SC_Simulation_Switch(sim, processes->pid_idx[running], time, err);
+    if (*err != NO_ERROR) {
+      break;
+    }
+    SC_Time until = time + quantum;
+    SC_SegmentReason reason = SC_SEGMENT_QUANTUM_EXPIRED;
+    if (remaining_time[running] <= quantum) {
+      until = time + remaining_time[running];
+      reason = SC_SEGMENT_COMPLETED;
+    }
+
+    SC_Simulation_Run(sim, processes->pid_idx[running], time, until, reason,
+                      err);
+    if (*err != NO_ERROR) {
+      break;
+    }
+
+    remaining_time[running] -= until - time;
+    time = until;
+    if (reason == SC_SEGMENT_COMPLETED) {
+      completed++;
+    } else {
+      SC_Time stride =
+          SC_STRIDE_ONE / SC_Share_Tickets(processes->priority[running]);
+      entry.key += stride;
+      SC_Heap_Push(&ready, entry, err);
+    }
+  }
+
+  if (*err == NO_ERROR) {
+    SC_Simulation_Finish(sim, processes, err);
+  }
+
+  free(arrivals);
+  free(remaining_time);
+  SC_Heap_Deinit(&ready);
+}
+
+/**
+ * How a real-time simulation picks the job that runs.
+ */
+typedef enum {
+  /** Earliest Deadline First, the job whose deadline is the closest runs. */
+  SC_RT_EARLIEST_DEADLINE,
+  /**
+   * Rate Monotonic, a static priority per task where the shortest period
+   * runs first. Processes that run once use their deadline as period.
+   */
+  SC_RT_RATE_MONOTONIC,
+} SC_RtPolicy;
+
+/**
+ * How a real-time simulation runs.
+ */
+typedef struct {
+  SC_RtPolicy policy;
+  /** Periodic tasks don't release jobs from this time on. */
+  SC_Time horizon;
+  /**
+   * Optional, if it's not `NULL` it ends up with the lateness of every job,
+   * 0 for the ones that met their deadline.
+   */
+  SC_Histogram *lateness;
+} SC_RtConfig;
+
+// Longest horizon `SC_RtConfig_Default` picks, hyperperiods can be huge.
+static const SC_Time SC_RT_MAX_DEFAULT_HORIZON = 10000000;
+
+/**
+ * Returns the least common multiple of the periods, after which periodic
+ * tasks repeat the same releases.
+ *
+ * It's 0 if there are no periodic tasks and `SC_TIME_MAX` if it overflows.
+ */
+SC_Time SC_Rt_Hyperperiod(SC_ProcessTable *processes) {
+  SC_Time hyperperiod = 0;
+  for (size_t i = 0; i < processes->count; i++) {
+    SC_Time period = processes->period[i];
+    if (period == 0) {
+      continue;
+    }
+    if (hyperperiod == 0) {
+      hyperperiod = period;
+      continue;
+    }
+
+    SC_Time a = hyperperiod;
+    SC_Time b = period;
+    while (b != 0) {
+      SC_Time rest = a % b;
+      a = b;
+      b = rest;
+    }
+    SC_Time factor = period / a;
+    if (hyperperiod > SC_TIME_MAX / factor) {
+      return SC_TIME_MAX;
+    }
+    hyperperiod *= factor;
+  }
+
+  return hyperperiod;
+}
+
+/**
+ * Releases jobs for a hyperperiod after the last periodic task starts, or
+ * until `SC_RT_MAX_DEFAULT_HORIZON` if that's sooner.
+ */
+SC_RtConfig SC_RtConfig_Default(SC_RtPolicy policy,
+                                SC_ProcessTable *processes) {
+  SC_Time last_start = 0;
+  for (size_t i = 0; i < processes->count; i++) {
+    if (processes->period[i] > 0) {
+      last_start = SC_Time_Max(last_start, processes->arrival_time[i]);
+    }
+  }
+
+  SC_Time hyperperiod = SC_Rt_Hyperperiod(processes);
+  SC_Time horizon = SC_RT_MAX_DEFAULT_HORIZON;
+  if (hyperperiod < horizon && last_start < horizon - hyperperiod) {
+    horizon = last_start + hyperperiod;
+  }
+
+  return (SC_RtConfig){.policy = policy, .horizon = horizon};
+}
+
+/**
+ * Whether the periodic tasks are guaranteed to meet their deadlines.
+ */
+typedef struct {
+  size_t task_count;
+  /** Fraction of the CPU the tasks need, the sum of `burst / period`. */
+  double utilization;
+  /** Like the utilization, but divided by the deadline if it's shorter. */
+  double density;
+  /** The Liu and Layland bound of Rate Monotonic, `n(2^(1/n) - 1)`. */
+  double rate_monotonic_bound;
+  SC_Bool edf_schedulable;
+  SC_Bool rate_monotonic_schedulable;
+} SC_RtSchedulability;
+
+/**
+ * Checks in O(n) if the periodic tasks are schedulable, processes that run
+ * once are ignored.
+ *
+ * EDF meets every deadline if the density is at most 1, which is exact when
+ * no deadline is shorter than its period. Rate Monotonic uses the hyperbolic
+ * bound, `prod(burst / period + 1) <= 2`, that accepts every set the Liu and
+ * Layland bound accepts and some more, and it's only checked if every
+ * deadline is the period. Both are sufficient tests, tasks that fail them may
+ * still meet their deadlines.
+ */
+SC_RtSchedulability SC_Rt_CheckSchedulability(SC_ProcessTable *processes) {
+  SC_RtSchedulability result = {0};
+  double hyperbolic_product = 1;
+  SC_Bool implicit_deadlines = SC_TRUE;
+  for (size_t i = 0; i < processes->count; i++) {
+    SC_Time period = processes->period[i];
+    if (period == 0) {
+      continue;
+    }
+
+    SC_Time deadline = processes->deadline[i];
+    SC_Time window = deadline > 0 && deadline < period ? deadline : period;
+    double utilization = (double)processes->burst_time[i] / period;
+    result.task_count++;
+    result.utilization += utilization;
+    result.density += (double)processes->burst_time[i] / window;
+    hyperbolic_product *= utilization + 1;
+    if (deadline > 0 && deadline != period) {
+      implicit_deadlines = SC_FALSE;
+    }
+  }
+
+  size_t count = result.task_count;
+  result.rate_monotonic_bound =
+      count > 0 ? count * (pow(2, 1.0 / count) - 1) : 1;
+  result.edf_schedulable = result.density <= 1;
+  result.rate_monotonic_schedulable =
+      implicit_deadlines && hyperbolic_product <= 2;
+  return result;
+}
+
+// The time a job released at `release` is due, `SC_TIME_MAX` if never.
+static SC_Time SC_Rt_Due(SC_Time release, SC_Time deadline) {
+  return deadline > SC_TIME_MAX - release ? SC_TIME_MAX : release + deadline;
+}
+
+// The key of a job on the ready queue, lower runs first.
+static SC_Time SC_Rt_Key(SC_RtPolicy policy, SC_Time period, SC_Time release,
+                         SC_Time deadline) {
+  if (policy == SC_RT_RATE_MONOTONIC) {
+    return period > 0 ? period : deadline;
+  }
+  return SC_Rt_Due(release, deadline);
+}
+
+/**
+ * Computes a real-time scheduling simulation of periodic tasks.
+ *
+ * A periodic task releases a job every `period` from its arrival until the
+ * horizon, and each job must run its burst time before its deadline. Jobs
+ * that miss it still run to completion. The ready queue holds one entry per
+ * task, keyed by the deadline of its oldest pending job or by its period,
+ * and the next release of every task waits on a second heap. Jobs are
+ * released lazily and only counted, so memory stays O(tasks) no matter how
+ * many jobs a hyperperiod has.
+ *
+ * The metrics are per job: the waiting time of a job is the time from its
+ * release until it completes minus its burst time. The waiting time of a
+ * process adds up the waiting time of all its jobs.
+ */
+void simulate_real_time(SC_ProcessTable *processes, SC_Simulation *sim,
+                        SC_RtConfig *config, SC_Err err) {
+  size_t n = processes->count;
+  SC_Time horizon = config->horizon;
+  // Release time of the oldest pending job of each task.
+  SC_Time *head_release = malloc(sizeof(SC_Time) * (n > 0 ? n : 1));
+  SC_Time *remaining_time = malloc(sizeof(SC_Time) * (n > 0 ? n : 1));
+  // Time after its release each job must complete, `SC_TIME_MAX` for none.
+  SC_Time *deadline = malloc(sizeof(SC_Time) * (n > 0 ? n : 1));
+  SC_Time *waiting = calloc(n > 0 ? n : 1, sizeof(SC_Time));
+  size_t *pending = calloc(n > 0 ? n : 1, sizeof(size_t));
+  SC_IndexedHeap releases = {0};
+  SC_IndexedHeap ready = {0};
+
+  if (!head_release || !remaining_time || !deadline || !waiting || !pending) {
+    *err = MALLOC_FAILED;
+  } else {
+    SC_IndexedHeap_Init(&releases, n, err);
+  }
+  if (*err == NO_ERROR) {
+    SC_IndexedHeap_Init(&ready, n, err);
+  }
+  if (*err == NO_ERROR) {
+    SC_Simulation_Init(sim, processes, err);
+  }
+  if (*err != NO_ERROR) {
+    free(head_release);
+    free(remaining_time);
+    free(deadline);
+    free(waiting);
+    free(pending);
+    SC_IndexedHeap_Deinit(&releases);
+    SC_IndexedHeap_Deinit(&ready);
+    return;
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    SC_Time period = processes->period[i];
+    deadline[i] = processes->deadline[i];
+    if (deadline[i] == 0) {
+      deadline[i] = period > 0 ? period : SC_TIME_MAX;
+    }
+
+    SC_Time arrival = processes->arrival_time[i];
+    if (processes->burst_time[i] > 0 && (period == 0 || arrival < horizon)) {
+      SC_IndexedHeap_Push(&releases, (SC_HeapEntry){.key = arrival, .idx = i});
+    }
+  }
+
+  SC_Histogram waiting_times;
+  SC_Histogram lateness;
+  SC_Histogram_Reset(&waiting_times);
+  SC_Histogram_Reset(&lateness);
+  double total_waiting_time = 0;
+  double total_turnaround_time = 0;
+  double total_response_time = 0;
+  SC_JainIndex slowdowns = {0};
+  SC_Time busy_time = 0;
+  SC_Time last_completion = 0;
+  size_t jobs = 0;
+  size_t deadline_misses = 0;
+  SC_Time time = 0;
+
+  while (releases.length > 0 || ready.length > 0) {
+    while (releases.length > 0 && SC_IndexedHeap_Peek(&releases).key <= time) {
+      SC_HeapEntry release = SC_IndexedHeap_Pop(&releases);
+      size_t idx = release.idx;
+      SC_Time period = processes->period[idx];
+      jobs++;
+
+      if (pending[idx]++ == 0) {
+        head_release[idx] = release.key;
+        remaining_time[idx] = processes->burst_time[idx];
+        SC_Time key =
+            SC_Rt_Key(config->policy, period, release.key, deadline[idx]);
+        SC_IndexedHeap_Push(&ready, (SC_HeapEntry){.key = key, .idx = idx});
+      }
+
+      if (period > 0 && period < horizon && release.key < horizon - period) {
+        SC_IndexedHeap_Push(&releases, (SC_HeapEntry){
+                                           .key = release.key + period,
+                                           .idx = idx,
+                                       });
+      }
+    }
+
+    SC_Time next_release =
+        releases.length > 0 ? SC_IndexedHeap_Peek(&releases).key : SC_TIME_MAX;
+    if (ready.length == 0) {
+      SC_Simulation_Run(sim, SC_NO_PROCESS, time, next_release,
+                        SC_SEGMENT_IDLE, err);
+      if (*err != NO_ERROR) {
+        break;
+      }
+      time = next_release;
+      continue;
+    }
+
+    size_t running = SC_IndexedHeap_Peek(&ready).idx;
+    // A release during the switch may give the CPU to another job.
+    SC_Time switched =
+        SC_Simulation_Switch(sim, processes->pid_idx[running], time, err);
+    if (*err != NO_ERROR) {
+      break;
+    }
+    if (switched > time) {
+      time = switched;
+      continue;
+    }
+
+    SC_Time burst_time = processes->burst_time[running];
+    if (remaining_time[running] == burst_time) {
+      total_response_time += time - head_release[running];
+    }
+
+    // The job runs until it completes or a release may preempt it.
+    SC_Time until = time + remaining_time[running];
+    SC_SegmentReason reason = SC_SEGMENT_COMPLETED;
+    if (next_release < until) {
+      until = next_release;
+      reason = SC_SEGMENT_PREEMPTED;
+    }
+
+    SC_Simulation_Run(sim, processes->pid_idx[running], time, until, reason,
+                      err);
+    if (*err != NO_ERROR) {
+      break;
+    }
+
+    remaining_time[running] -= until - time;
+    busy_time += until - time;
+    time = until;
+    if (reason != SC_SEGMENT_COMPLETED) {
+      continue;
+    }
+
+    SC_Time release = head_release[running];
+    SC_Time job_waiting_time = time - release - burst_time;
+    total_waiting_time += job_waiting_time;
+    total_turnaround_time += time - release;
+    SC_JainIndex_Record(&slowdowns, time - release, burst_time);
+    waiting[running] += job_waiting_time;
+    SC_Histogram_Record(&waiting_times, job_waiting_time);
+
+    SC_Time due = SC_Rt_Due(release, deadline[running]);
+    if (time > due) {
+      deadline_misses++;
+    }
+    SC_Histogram_Record(&lateness, time > due ? time - due : 0);
+    last_completion = time;
+
+    SC_IndexedHeap_Remove(&ready, running);
+    if (--pending[running] > 0) {
+      SC_Time period = processes->period[running];
+      head_release[running] += period;
+      remaining_time[running] = burst_time;
+      SC_Time key = SC_Rt_Key(config->policy, period, head_release[running],
+                              deadline[running]);
+      SC_IndexedHeap_Push(&ready, (SC_HeapEntry){.key = key, .idx = running});
+    }
+  }
+
+  if (*err == NO_ERROR) {
+    SC_Simulation_Finish(sim, processes, err);
+  }
+  if (*err == NO_ERROR) {
+    memcpy(processes->waiting_time, waiting, sizeof(SC_Time) * n);
+    sim->jobs = jobs;
+    sim->deadline_misses = deadline_misses;
+    sim->avg_waiting_time = jobs > 0 ? total_waiting_time / jobs : 0;
+    sim->avg_turnaround_time = jobs > 0 ? total_turnaround_time / jobs : 0;
+    sim->avg_response_time = jobs > 0 ? total_response_time / jobs : 0;
+    // Without a completed job, the ones `SC_Simulation_Finish` computed match
+    // every other algorithm.
+    if (last_completion > 0) {
+      sim->makespan = last_completion;
+      sim->throughput = (double)jobs / last_completion;
+      sim->cpu_utilization = (double)busy_time / last_completion;
+    }
+    sim->waiting_p50 = SC_Histogram_Percentile(&waiting_times, 50);
+    sim->waiting_p90 = SC_Histogram_Percentile(&waiting_times, 90);
+    sim->waiting_p99 = SC_Histogram_Percentile(&waiting_times, 99);
+    sim->waiting_max = waiting_times.max;
+    sim->lateness_p99 = SC_Histogram_Percentile(&lateness, 99);
+    sim->lateness_max = lateness.max;
+    sim->fairness = SC_JainIndex_Compute(&slowdowns);
+    sim->cpu_efficiency = SC_Simulation_Efficiency(sim, busy_time);
+    if (NULL != config->lateness) {
+      *config->lateness = lateness;
+    }
+  }
+
+  free(head_release);
+  free(remaining_time);
+  free(deadline);
+  free(waiting);
+  free(pending);
+  SC_IndexedHeap_Deinit(&releases);
+  SC_IndexedHeap_Deinit(&ready);
+}
+
+/**
+ * The policy every CPU of an SMP simulation uses on its own run queue.
+ */
+typedef enum {
+  SC_SMP_FIFO,
+  SC_SMP_SHORTEST_FIRST,
+  SC_SMP_SHORTEST_REMAINING,
+  SC_SMP_ROUND_ROBIN,
+  SC_SMP_PRIORITY,
+  SC_SMP_PRIORITY_PREEMPTIVE,
+} SC_SmpPolicy;
+
+/**
+ * How a multi-core simulation runs.
+ */
+typedef struct {
+  SC_SmpPolicy policy;
+  size_t cpu_count;
+  /** Only used by `SC_SMP_ROUND_ROBIN`. */
+  int quantum;
+  /**
+   * Time a process spends warming up on a CPU different from the one it
+   * last ran on, before it makes progress again.
+   */
+  SC_Time migration_cost;
+} SC_SmpConfig;
+
+/**
+ * An I/O device of an SMP simulation, it serves one process at a time and
+ * the rest queue in FIFO order.
+ */
+typedef struct {
+  /** The slot doing I/O on the device, or `SC_NO_SLOT`. */
+  size_t serving;
+  /** The first and last slots of the queue, or `SC_NO_SLOT`. */
+  size_t head;
+  size_t tail;
+} SC_SmpDevice;
+
+/**
+ * The state of a single CPU of an SMP simulation.
+ */
+typedef struct {
+  /** Ready processes assigned to this CPU, ordered by the policy's key. */
+  SC_Heap queue;
+  /** The running slot, or `SC_NO_SLOT`. */
+  size_t running;
+  /** When the running process got the CPU. */
+  SC_Time dispatched_at;
+  /** When the CPU is done switching to the running process. */
+  SC_Time switch_end;
+  /** When the running process starts progressing, after migrating. */
+  SC_Time run_start;
+  /** When the running process leaves the CPU if nothing preempts it. */
+  SC_Time slice_end;
+  /** When the CPU ran out of work. */
+  SC_Time idle_since;
+  /** Time units the CPU spent making progress on processes. */
+  SC_Time busy_time;
+} SC_SmpCpu;
+
+/**
+ * Shared state of `simulate_smp`, so its steps can live on small functions.
+ */
+typedef struct {
+  SC_SmpConfig config;
+  SC_ProcessTable *processes;
+  SC_Simulation *sim;
+  SC_SmpCpu *cpus;
+  SC_Time *remaining_time;
+  /** The CPU each process last ran on, or `SC_NO_SLOT`. */
+  size_t *last_cpu;
+  /** Round Robin queues in the order processes became ready. */
+  SC_Time sequence;
+  /**
+   * The cycle each process is on, `NULL` if none does I/O. The rest of the
+   * I/O state is only used when it's set.
+   */
+  size_t *cycle;
+  /** When each process blocked on its current I/O burst. */
+  SC_Time *blocked_since;
+  /** The next slot on the queue of the same device. */
+  size_t *device_next;
+  SC_SmpDevice devices[SC_IO_MAX_DEVICES];
+  /** Wakes up each process when its I/O burst ends. */
+  SC_TimerWheel timers;
+} SC_SmpState;
+
+static SC_Bool SC_SmpPolicy_IsPreemptive(SC_SmpPolicy policy) {
+  return policy == SC_SMP_SHORTEST_REMAINING ||
+         policy == SC_SMP_PRIORITY_PREEMPTIVE;
+}
+
+// The time `slot` needs on the CPU for its current burst.
+static SC_Time SC_Smp_Burst(SC_SmpState *state, size_t slot) {
+  if (NULL == state->cycle || state->processes->cycle_count[slot] == 0) {
+    return state->processes->burst_time[slot];
+  }
+  return SC_ProcessTable_Cycles(state->processes, slot)[state->cycle[slot]]
+      .cpu_time;
+}
+
+// The key `slot` gets on a run queue, lower runs first.
+static SC_Time SC_Smp_Key(SC_SmpState *state, size_t slot) {
+  switch (state->config.policy) {
+  case SC_SMP_SHORTEST_FIRST:
+    return SC_Smp_Burst(state, slot);
+  case SC_SMP_SHORTEST_REMAINING:
+    return state->remaining_time[slot];
+  case SC_SMP_ROUND_ROBIN:
+    return state->sequence++;
+  case SC_SMP_PRIORITY:
+  case SC_SMP_PRIORITY_PREEMPTIVE:
+    return state->processes->priority[slot];
+  case SC_SMP_FIFO:
+  default:
+    // Processes back from I/O queue behind the ones that are already ready.
+    if (NULL != state->cycle) {
+      return state->sequence++;
+    }
+    return state->processes->arrival_time[slot];
+  }
+}
+
+static void SC_Smp_Enqueue(SC_SmpState *state, size_t cpu, size_t slot,
+                           SC_Err err) {
+  SC_HeapEntry entry = {.key = SC_Smp_Key(state, slot), .idx = slot};
+  SC_Heap_Push(&state->cpus[cpu].queue, entry, err);
+}
 
-  float total_waiting_time = 0;
-  SC_ProcessList_Node *nnode = processes->head;
-  while (nnode != NULL) {
-    total_waiting_time += nnode->value.waiting_time;
-    nnode = nnode->next;
+// Places a new process on an idle CPU, or else on the least loaded one.
+static size_t SC_Smp_PickCpu(SC_SmpState *state) {
+  size_t best = 0;
+  size_t best_load = SIZE_MAX;
+  for (size_t cpu = 0; cpu < state->config.cpu_count; cpu++) {
+    SC_SmpCpu *current = &state->cpus[cpu];
+    size_t load =
+        current->queue.length + (current->running != SC_NO_SLOT ? 1 : 0);
+    if (load < best_load) {
+      best = cpu;
+      best_load = load;
+    }
   }
-  sim->avg_waiting_time = total_waiting_time / (float)n;
-
-  free(remaining_bursts);
-  free(proc_array);
+  return best;
 }
 
-void simulate_shortest_first(SC_ProcessList *processes, SC_Simulation *sim) {
-  int n = processes->count;
-
-  SC_Process **proc_array = malloc(sizeof(SC_Process *) * n);
-  SC_ProcessList_Node *node = processes->head;
-  for (int i = 0; i < n && node != NULL; i++, node = node->next) {
-    proc_array[i] = &node->value;
+/**
+ * Sends `slot` to the I/O burst of its current cycle at `time`. It waits
+ * for its device if another process is using it.
+ */
+static void SC_Smp_Block(SC_SmpState *state, size_t slot, SC_Time time) {
+  SC_IoCycle *cycle =
+      &SC_ProcessTable_Cycles(state->processes, slot)[state->cycle[slot]];
+  state->blocked_since[slot] = time;
+  if (cycle->device == SC_IO_SLEEP) {
+    SC_TimerWheel_Schedule(&state->timers, slot, time + cycle->io_time);
+    return;
   }
 
-  qsort(proc_array, n, sizeof(SC_Process *), compare_proc_ptrBT);
-
-  int totalBurstTime = 0;
-  for (int i = 0; i < n; i++) {
-    totalBurstTime += proc_array[i]->burst_time;
+  SC_SmpDevice *device = &state->devices[cycle->device];
+  if (device->serving == SC_NO_SLOT) {
+    device->serving = slot;
+    SC_TimerWheel_Schedule(&state->timers, slot, time + cycle->io_time);
+    return;
   }
 
-  sim->step_length = totalBurstTime;
-  sim->current_step = 0;
-  sim->steps = malloc(sizeof(SC_SimStepState) * totalBurstTime);
-
-  int *remaining_bursts = malloc(sizeof(int) * n);
-  for (int i = 0; i < n; i++) {
-    remaining_bursts[i] = proc_array[i]->burst_time;
+  state->device_next[slot] = SC_NO_SLOT;
+  if (device->tail == SC_NO_SLOT) {
+    device->head = slot;
+  } else {
+    state->device_next[device->tail] = slot;
   }
+  device->tail = slot;
+}
 
-  int time = 0;
-  int elapsed_time = 0;
-
-  for (int pidx = 0; pidx < n; pidx++) {
-    SC_Process *proc = proc_array[pidx];
-
-    int waiting_time = elapsed_time;
-    if (waiting_time < 0)
-      waiting_time = 0;
-
-    proc->waiting_time = waiting_time;
-
-    for (int b = 0; b < proc->burst_time; b++) {
-      SC_SimStepState *step = &sim->steps[time];
-      step->current_process = proc->pid_idx;
-
-      step->process_length = n;
-      step->processes = malloc(sizeof(SC_Process) * n);
-
-      SC_ProcessList_Node *orig = processes->head;
-      int j = 0;
-      while (orig != NULL) {
-        SC_Process copy = orig->value;
-
-        for (int k = 0; k < n; k++) {
-          if (copy.pid_idx == proc_array[k]->pid_idx) {
-            int adjusted_burst = remaining_bursts[k] - (k == pidx ? 1 : 0);
-            copy.burst_time = adjusted_burst < 0 ? 0 : adjusted_burst;
-            if (k == pidx) {
-              copy.waiting_time = waiting_time;
-            } else {
-              copy.waiting_time = 0;
-            }
-            break;
-          }
-        }
-
-        step->processes[j++] = copy;
-        orig = orig->next;
+/**
+ * Ends the I/O burst of `slot` at `time`, its device serves the next process
+ * on its queue and `slot` goes to a run queue for its next CPU burst.
+ */
+static void SC_Smp_Wake(SC_SmpState *state, size_t slot, SC_Time time,
+                        SC_Err err) {
+  SC_IoCycle *cycles = SC_ProcessTable_Cycles(state->processes, slot);
+  SC_IoCycle *cycle = &cycles[state->cycle[slot]];
+  if (cycle->device != SC_IO_SLEEP) {
+    SC_SmpDevice *device = &state->devices[cycle->device];
+    device->serving = device->head;
+    if (device->head != SC_NO_SLOT) {
+      size_t next = device->head;
+      device->head = state->device_next[next];
+      if (device->head == SC_NO_SLOT) {
+        device->tail = SC_NO_SLOT;
       }
 
-      remaining_bursts[pidx]--;
-      time++;
+      SC_IoCycle *next_cycle = &SC_ProcessTable_Cycles(
+          state->processes, next)[state->cycle[next]];
+      SC_TimerWheel_Schedule(&state->timers, next, time + next_cycle->io_time);
     }
-
-    elapsed_time += proc->burst_time;
   }
 
-  float total_waiting_time = 0;
-  SC_ProcessList_Node *ptr = processes->head;
-  while (ptr != NULL) {
-    total_waiting_time += ptr->value.waiting_time;
-    ptr = ptr->next;
+  SC_Simulation_Wake(state->sim, state->processes->pid_idx[slot],
+                     state->blocked_since[slot], time, cycle->io_time, err);
+  if (*err != NO_ERROR) {
+    return;
   }
 
-  sim->avg_waiting_time = (total_waiting_time) / (float)n;
-
-  free(remaining_bursts);
-  free(proc_array);
+  state->cycle[slot]++;
+  state->remaining_time[slot] = cycles[state->cycle[slot]].cpu_time;
+  SC_Smp_Enqueue(state, SC_Smp_PickCpu(state), slot, err);
 }
 
-void simulate_shortest_remaining(SC_ProcessList *processes,
-                                 SC_Simulation *sim) {
-  if (!processes || !sim || processes->count == 0)
+/**
+ * Takes the running process off `cpu` at `time` and records what it did.
+ *
+ * If it has no time left it completes, or blocks on I/O if it has more
+ * cycles. Otherwise it ends with `reason` and goes back to the run queue of
+ * the same CPU.
+ */
+static void SC_Smp_Stop(SC_SmpState *state, size_t cpu, SC_Time time,
+                        SC_SegmentReason reason, size_t *completed,
+                        SC_Err err) {
+  SC_SmpCpu *current = &state->cpus[cpu];
+  size_t slot = current->running;
+  size_t pid_idx = state->processes->pid_idx[slot];
+
+  SC_Time switched = SC_Time_Min(current->switch_end, time);
+  SC_Time warmed_up = SC_Time_Min(current->run_start, time);
+  SC_Simulation_RunOn(state->sim, cpu, pid_idx, current->dispatched_at,
+                      switched, SC_SEGMENT_SWITCH, err);
+  if (*err != NO_ERROR) {
     return;
-
-  int totalBurstTime = SC_Total_busrt_time(processes) + 1;
-  if (totalBurstTime <= 0)
+  }
+  SC_Simulation_RunOn(state->sim, cpu, pid_idx, switched, warmed_up,
+                      SC_SEGMENT_MIGRATION, err);
+  if (*err != NO_ERROR) {
     return;
-
-  sim->steps = calloc(totalBurstTime, sizeof(SC_SimStepState));
-  sim->step_length = totalBurstTime;
-  sim->current_step = 0;
-
-  int n = processes->count;
-
-  SC_Process **proc_array = malloc(sizeof(SC_Process *) * n);
-  SC_ProcessList_Node *node = processes->head;
-  for (int i = 0; i < n && node != NULL; i++, node = node->next) {
-    proc_array[i] = &node->value;
   }
 
-  int *remaining_time = malloc(n * sizeof(int));
-  int *start_time = malloc(n * sizeof(int));
-  int *finish_time = malloc(n * sizeof(int));
+  SC_Time progress = time - warmed_up;
+  state->remaining_time[slot] -= progress;
+  current->busy_time += progress;
+  current->running = SC_NO_SLOT;
+  current->idle_since = time;
 
-  if (!remaining_time || !start_time || !finish_time || !proc_array) {
-    free(proc_array);
-    free(remaining_time);
-    free(start_time);
-    free(finish_time);
+  if (state->remaining_time[slot] == 0) {
+    if (NULL != state->cycle &&
+        state->cycle[slot] + 1 < state->processes->cycle_count[slot]) {
+      reason = SC_SEGMENT_BLOCKED;
+    } else {
+      reason = SC_SEGMENT_COMPLETED;
+      (*completed)++;
+    }
+  }
+  SC_Simulation_RunOn(state->sim, cpu, pid_idx, warmed_up, time, reason, err);
+  if (*err != NO_ERROR || reason == SC_SEGMENT_COMPLETED) {
     return;
   }
 
-  for (int i = 0; i < n; i++) {
-    remaining_time[i] = proc_array[i]->burst_time;
-    start_time[i] = -1;
-    finish_time[i] = -1;
+  if (reason == SC_SEGMENT_BLOCKED) {
+    SC_Smp_Block(state, slot, time);
+    return;
   }
+  SC_Smp_Enqueue(state, cpu, slot, err);
+}
 
-  int time = 0;
-  int completed = 0;
-
-  while (completed < n && time < totalBurstTime - 1) {
-    int shortest = -1;
-    for (int j = 0; j < n; j++) {
-      if (proc_array[j]->arrival_time <= time && remaining_time[j] > 0) {
-        if (shortest == -1 || remaining_time[j] < remaining_time[shortest]) {
-          shortest = j;
-        }
-      }
-    }
-
-    SC_SimStepState *step = &sim->steps[time];
-    step->process_length = n;
-    step->current_process =
-        (shortest != -1) ? proc_array[shortest]->pid_idx : -1;
-    step->processes = malloc(sizeof(SC_Process) * n);
+/**
+ * Gives `cpu` the next process of its queue. If it's empty and `steal` is
+ * set, it takes the next process of another CPU instead.
+ */
+static void SC_Smp_Dispatch(SC_SmpState *state, size_t cpu, SC_Time time,
+                            SC_Bool steal, SC_Err err) {
+  SC_SmpCpu *current = &state->cpus[cpu];
+  SC_Heap *queue = &current->queue;
 
-    SC_ProcessList_Node *temp = processes->head;
-    for (int k = 0; k < n && temp != NULL; k++, temp = temp->next) {
-      step->processes[k] = temp->value;
-      step->processes[k].burst_time = remaining_time[k];
+  if (queue->length == 0) {
+    if (!steal) {
+      return;
     }
 
-    if (shortest != -1) {
-      if (start_time[shortest] == -1)
-        start_time[shortest] = time;
-      remaining_time[shortest]--;
-      if (remaining_time[shortest] == 0) {
-        finish_time[shortest] = time + 1;
-        completed++;
+    // Steals the next process of the CPU with the longest queue.
+    for (size_t other = 0; other < state->config.cpu_count; other++) {
+      if (state->cpus[other].queue.length > queue->length) {
+        queue = &state->cpus[other].queue;
       }
     }
-    time++;
-  }
-
-  if (time < totalBurstTime) {
-    SC_SimStepState *step = &sim->steps[time];
-    step->process_length = n;
-    step->current_process = -1;
-    step->processes = malloc(sizeof(SC_Process) * n);
-
-    SC_ProcessList_Node *temp = processes->head;
-    for (int k = 0; k < n && temp != NULL; k++, temp = temp->next) {
-      step->processes[k] = temp->value;
-      step->processes[k].burst_time = 0;
+    if (queue->length == 0) {
+      return;
     }
-    sim->step_length = time + 1;
   }
 
-  float total_waiting = 0.0f;
-  for (int j = 0; j < n; j++) {
-    int turnaround = finish_time[j] - proc_array[j]->arrival_time;
-    int waiting = turnaround - proc_array[j]->burst_time;
-
-    if (waiting < 0)
-      waiting = 0;
+  size_t slot = SC_Heap_Pop(queue).idx;
+  SC_Simulation_RunOn(state->sim, cpu, SC_NO_PROCESS, current->idle_since,
+                      time, SC_SEGMENT_IDLE, err);
+  if (*err != NO_ERROR) {
+    return;
+  }
 
-    proc_array[j]->waiting_time = waiting;
-    total_waiting += waiting;
+  current->running = slot;
+  current->dispatched_at = time;
+  current->switch_end =
+      time + SC_Simulation_SwitchCost(state->sim, cpu,
+                                      state->processes->pid_idx[slot], time);
+  current->run_start = current->switch_end;
+  if (state->last_cpu[slot] != SC_NO_SLOT && state->last_cpu[slot] != cpu) {
+    current->run_start += state->config.migration_cost;
+    state->sim->migrations++;
   }
-  sim->avg_waiting_time = total_waiting / (float)n;
+  state->last_cpu[slot] = cpu;
 
-  free(proc_array);
-  free(remaining_time);
-  free(start_time);
-  free(finish_time);
+  SC_Time slice = state->remaining_time[slot];
+  if (state->config.policy == SC_SMP_ROUND_ROBIN) {
+    slice = SC_Time_Min(slice, (SC_Time)state->config.quantum);
+  }
+  current->slice_end = current->run_start + slice;
 }
 
-void simulate_round_robin(SC_ProcessList *processes, SC_Simulation *sim,
-                          int quantum) {
-  if (!processes || !sim || processes->count == 0 || quantum <= 0)
+/**
+ * Preempts the process running on `cpu` if the top of its queue should run
+ * instead. Only called for preemptive policies.
+ */
+static void SC_Smp_Preempt(SC_SmpState *state, size_t cpu, SC_Time time,
+                           size_t *completed, SC_Err err) {
+  SC_SmpCpu *current = &state->cpus[cpu];
+  if (current->running == SC_NO_SLOT || current->queue.length == 0) {
     return;
+  }
 
-  // SC_ProcessList_sort(processes, compare_by_arrival_time);
-  int totalBurstTime = SC_Total_busrt_time(processes) + 1;
-  int n = processes->count;
+  size_t slot = current->running;
+  SC_Time key = state->processes->priority[slot];
+  if (state->config.policy == SC_SMP_SHORTEST_REMAINING) {
+    SC_Time progress =
+        time > current->run_start ? time - current->run_start : 0;
+    key = state->remaining_time[slot] - progress;
+  }
 
-  sim->steps = calloc(totalBurstTime * 2, sizeof(SC_SimStepState));
-  sim->step_length = 0;
-  sim->current_step = 0;
+  if (SC_Heap_Peek(&current->queue).key < key) {
+    SC_Smp_Stop(state, cpu, time, SC_SEGMENT_PREEMPTED, completed, err);
+  }
+}
 
-  SC_Process **proc_array = malloc(sizeof(SC_Process *) * n);
-  SC_ProcessList_Node *node = processes->head;
-  for (int i = 0; i < n && node != NULL; i++, node = node->next) {
-    proc_array[i] = &node->value;
+// Computes how much busier the busiest CPU was than the average one.
+static float SC_Smp_LoadImbalance(SC_SmpState *state) {
+  SC_Time total = 0;
+  SC_Time busiest = 0;
+  for (size_t cpu = 0; cpu < state->config.cpu_count; cpu++) {
+    total += state->cpus[cpu].busy_time;
+    busiest = SC_Time_Max(busiest, state->cpus[cpu].busy_time);
+  }
+  if (total == 0) {
+    return 0;
   }
 
-  int *remaining_time = malloc(sizeof(int) * n);
-  int *start_time = malloc(sizeof(int) * n);
-  int *finish_time = malloc(sizeof(int) * n);
-  int *visited = calloc(n, sizeof(int));
+  double mean = (double)total / state->config.cpu_count;
+  return busiest / mean - 1;
+}
 
-  if (!proc_array || !remaining_time || !start_time || !finish_time ||
-      !visited) {
-    free(proc_array);
-    free(remaining_time);
-    free(start_time);
-    free(finish_time);
-    free(visited);
-    return;
+/**
+ * Computes a multi-core scheduling simulation with one run queue per CPU.
+ *
+ * Arriving processes go to an idle CPU, or to the one with the fewest
+ * processes. Every CPU schedules its own queue with `config->policy`, and a
+ * CPU that runs out of work steals the next process of the longest queue.
+ * A process that resumes on a different CPU than the one it last ran on
+ * spends `config->migration_cost` time units migrating before it progresses,
+ * after the CPU switches to it.
+ *
+ * Unlike the single CPU simulators, every policy waits for processes to
+ * arrive, and priorities don't age.
+ *
+ * Processes with I/O cycles block after each CPU burst but the last one.
+ * They queue for their device in FIFO order, and a timer wheel wakes them
+ * up when their I/O burst ends, so sleeping processes cost nothing until
+ * then. Shortest First looks at the current CPU burst, and First In First
+ * Out at when the process became ready.
+ *
+ * At every event time the slices that end are stopped first, then I/O that
+ * ended wakes up its processes, arrivals are placed, preemptions are checked
+ * and idle CPUs are given work, so the cost is O(cpu_count) per event plus
+ * O(log n) per queue operation.
+ */
+void simulate_smp(SC_ProcessTable *processes, SC_Simulation *sim,
+                  SC_SmpConfig *config, SC_Err err) {
+  size_t n = processes->count;
+  size_t cpu_count = config->cpu_count > 0 ? config->cpu_count : 1;
+
+  SC_SmpState state = {
+      .config = *config,
+      .processes = processes,
+      .sim = sim,
+  };
+  state.config.cpu_count = cpu_count;
+  if (state.config.quantum <= 0) {
+    state.config.quantum = 1;
   }
 
-  for (int i = 0; i < n; i++) {
-    remaining_time[i] = proc_array[i]->burst_time;
-    start_time[i] = -1;
-    finish_time[i] = -1;
+  SC_HeapEntry *arrivals = malloc(sizeof(SC_HeapEntry) * (n > 0 ? n : 1));
+  state.remaining_time = malloc(sizeof(SC_Time) * (n > 0 ? n : 1));
+  state.last_cpu = malloc(sizeof(size_t) * (n > 0 ? n : 1));
+  state.cpus = calloc(cpu_count, sizeof(SC_SmpCpu));
+  if (!arrivals || !state.remaining_time || !state.last_cpu || !state.cpus) {
+    *err = MALLOC_FAILED;
   }
 
-  int *queue = malloc(sizeof(int) * totalBurstTime * 2);
-  if (!queue) {
-    free(proc_array);
-    free(remaining_time);
-    free(start_time);
-    free(finish_time);
-    free(visited);
-    return;
+  SC_Bool has_io = SC_ProcessTable_HasIo(processes);
+  if (has_io && *err == NO_ERROR) {
+    state.cycle = calloc(n > 0 ? n : 1, sizeof(size_t));
+    state.blocked_since = malloc(sizeof(SC_Time) * (n > 0 ? n : 1));
+    state.device_next = malloc(sizeof(size_t) * (n > 0 ? n : 1));
+    if (!state.cycle || !state.blocked_since || !state.device_next) {
+      *err = MALLOC_FAILED;
+    }
+  }
+  if (has_io && *err == NO_ERROR) {
+    SC_TimerWheel_Init(&state.timers, n, err);
+  }
+  for (size_t device = 0; device < SC_IO_MAX_DEVICES; device++) {
+    state.devices[device] = (SC_SmpDevice){
+        .serving = SC_NO_SLOT,
+        .head = SC_NO_SLOT,
+        .tail = SC_NO_SLOT,
+    };
   }
 
-  int front = 0, rear = 0;
-  int time = 0;
-  int completed = 0;
-  int current_process = -1;
-  int time_slice = 0;
+  for (size_t cpu = 0; cpu < cpu_count && *err == NO_ERROR; cpu++) {
+    state.cpus[cpu].running = SC_NO_SLOT;
+    SC_Heap_Init(&state.cpus[cpu].queue, n / cpu_count + 1, err);
+  }
+  if (*err == NO_ERROR) {
+    SC_Simulation_InitCpus(sim, processes, cpu_count, err);
+  }
+  if (has_io && *err == NO_ERROR) {
+    SC_Simulation_TrackIo(sim, err);
+  }
 
-  while (completed < n || current_process != -1) {
-    for (int j = 0; j < n; j++) {
-      if (proc_array[j]->arrival_time == time && remaining_time[j] > 0 &&
-          !visited[j]) {
-        queue[rear++] = j;
-        visited[j] = 1;
-      }
+  size_t completed = 0;
+  for (size_t i = 0; i < n && *err == NO_ERROR; i++) {
+    arrivals[i] = (SC_HeapEntry){.key = processes->arrival_time[i], .idx = i};
+    state.remaining_time[i] = SC_Smp_Burst(&state, i);
+    state.last_cpu[i] = SC_NO_SLOT;
+    if (state.remaining_time[i] == 0) {
+      completed++;
     }
+  }
+  if (*err == NO_ERROR) {
+    SC_HeapEntry_Sort(arrivals, n);
+  }
 
-    if (current_process == -1 && front < rear) {
-      current_process = queue[front++];
-      time_slice = 0;
+  SC_Time time = 0;
+  size_t cursor = 0;
+  SC_Bool preemptive = SC_SmpPolicy_IsPreemptive(config->policy);
+  while (*err == NO_ERROR && completed < n) {
+    for (size_t cpu = 0; cpu < cpu_count && *err == NO_ERROR; cpu++) {
+      SC_SmpCpu *current = &state.cpus[cpu];
+      if (current->running != SC_NO_SLOT && current->slice_end == time) {
+        SC_Smp_Stop(&state, cpu, time, SC_SEGMENT_QUANTUM_EXPIRED, &completed,
+                    err);
+      }
     }
 
-    SC_SimStepState *step = &sim->steps[sim->step_length++];
-    step->current_process =
-        (current_process != -1) ? proc_array[current_process]->pid_idx : -1;
-    step->process_length = n;
-    step->processes = malloc(sizeof(SC_Process) * n);
+    if (has_io && *err == NO_ERROR) {
+      SC_TimerWheel_Advance(&state.timers, time);
+      size_t slot = 0;
+      while (*err == NO_ERROR && SC_TimerWheel_Pop(&state.timers, &slot)) {
+        SC_Smp_Wake(&state, slot, time, err);
+      }
+    }
 
-    SC_ProcessList_Node *temp = processes->head;
-    for (int k = 0; k < n && temp; k++, temp = temp->next) {
-      step->processes[k] = temp->value;
-      step->processes[k].burst_time = remaining_time[k];
+    for (; cursor < n && arrivals[cursor].key <= time && *err == NO_ERROR;
+         cursor++) {
+      size_t slot = arrivals[cursor].idx;
+      if (state.remaining_time[slot] > 0) {
+        SC_Smp_Enqueue(&state, SC_Smp_PickCpu(&state), slot, err);
+      }
     }
 
-    if (current_process != -1) {
-      if (start_time[current_process] == -1)
-        start_time[current_process] = time;
+    for (size_t cpu = 0; cpu < cpu_count && *err == NO_ERROR; cpu++) {
+      if (preemptive) {
+        SC_Smp_Preempt(&state, cpu, time, &completed, err);
+      }
+      if (*err == NO_ERROR && state.cpus[cpu].running == SC_NO_SLOT) {
+        SC_Smp_Dispatch(&state, cpu, time, SC_FALSE, err);
+      }
+    }
 
-      remaining_time[current_process]--;
-      time_slice++;
+    // CPUs only steal once every CPU took its own work.
+    for (size_t cpu = 0; cpu < cpu_count && *err == NO_ERROR; cpu++) {
+      if (state.cpus[cpu].running == SC_NO_SLOT) {
+        SC_Smp_Dispatch(&state, cpu, time, SC_TRUE, err);
+      }
+    }
 
-      if (remaining_time[current_process] == 0) {
-        finish_time[current_process] = time + 1;
-        completed++;
-        current_process = -1;
-      } else if (time_slice == quantum) {
-        queue[rear++] = current_process;
-        current_process = -1;
+    SC_Time next_event = cursor < n ? arrivals[cursor].key : SC_TIME_MAX;
+    if (has_io) {
+      next_event =
+          SC_Time_Min(next_event, SC_TimerWheel_NextExpiry(&state.timers));
+    }
+    for (size_t cpu = 0; cpu < cpu_count; cpu++) {
+      if (state.cpus[cpu].running != SC_NO_SLOT) {
+        next_event = SC_Time_Min(next_event, state.cpus[cpu].slice_end);
       }
     }
-    time++;
+    time = next_event;
   }
 
-  float total_waiting = 0.0f;
-  for (int j = 0; j < n; j++) {
-    int turnaround = finish_time[j] - proc_array[j]->arrival_time;
-    int waiting = turnaround - proc_array[j]->burst_time;
-
-    if (waiting < 0)
-      waiting = 0;
-
-    proc_array[j]->waiting_time = waiting;
-    total_waiting += waiting;
+  if (*err == NO_ERROR) {
+    sim->load_imbalance = SC_Smp_LoadImbalance(&state);
+    SC_Simulation_Finish(sim, processes, err);
   }
 
-  sim->avg_waiting_time = total_waiting / (float)n;
-
-  free(proc_array);
-  free(remaining_time);
-  free(start_time);
-  free(finish_time);
-  free(queue);
-  free(visited);
+  if (NULL != state.cpus) {
+    for (size_t cpu = 0; cpu < cpu_count; cpu++) {
+      SC_Heap_Deinit(&state.cpus[cpu].queue);
+    }
+  }
+  free(state.cpus);
+  free(arrivals);
+  free(state.remaining_time);
+  free(state.last_cpu);
+  free(state.cycle);
+  free(state.blocked_since);
+  free(state.device_next);
+  SC_TimerWheel_Deinit(&state.timers);
 }
 
-void simulate_priority(SC_ProcessList *processes, SC_Simulation *sim) {
-  int n = processes->count;
+/**
+ * Parses the bursts of a process. Either a single CPU burst, like `4`, or CPU
+ * bursts separated by I/O bursts on a device, like `4 1:3 5`: 4 on the CPU, 3
+ * on device 1 and 5 more on the CPU. Device 0 just sleeps.
+ */
+static void SC_Process_ParseBursts(SC_ProcessTable *table, SC_Process *process,
+                                   SC_String *buffer, SC_Err err) {
+  process->burst_time = 0;
+  process->io_time = 0;
+  process->first_cycle = table->cycles.length;
+  process->cycle_count = 0;
+
+  SC_IoCycle cycle = {0};
+  size_t tokens = 0;
+  size_t start = 0;
+  for (size_t i = 0; i <= buffer->length; i++) {
+    if (i < buffer->length && buffer->data[i] != ' ') {
+      continue;
+    }
+    SC_String token = {
+        .data = buffer->data + start,
+        .length = i - start,
+        .data_capacity = i - start,
+    };
+    start = i + 1;
+    if (token.length == 0) {
+      continue;
+    }
 
-  SC_Process **proc_array = malloc(sizeof(SC_Process *) * n);
-  SC_ProcessList_Node *node = processes->head;
-  for (int i = 0; i < n && node != NULL; i++, node = node->next) {
-    proc_array[i] = &node->value;
-  }
+    if (tokens % 2 == 0) {
+      // A CPU burst closes the cycle of the one before it.
+      if (tokens > 0) {
+        SC_ProcessTable_AppendCycle(table, cycle, err);
+        if (*err != NO_ERROR) {
+          return;
+        }
+      }
 
-  qsort(proc_array, n, sizeof(SC_Process *), compare_proc_ptrP);
+      cycle = (SC_IoCycle){.cpu_time = SC_String_ParseTime(&token, err)};
+      if (*err != NO_ERROR) {
+        return;
+      }
+      if (cycle.cpu_time > SC_TIME_MAX - process->burst_time) {
+        *err = INVALID_STRING;
+        return;
+      }
+      process->burst_time += cycle.cpu_time;
+    } else {
+      size_t colon = 0;
+      while (colon < token.length && token.data[colon] != ':') {
+        colon++;
+      }
+      if (colon == token.length) {
+        *err = INVALID_TXT_FILE;
+        return;
+      }
 
-  int totalBurstTime = 0;
-  for (int i = 0; i < n; i++) {
-    totalBurstTime += proc_array[i]->burst_time;
+      SC_String device = {.data = token.data, .length = colon};
+      SC_String time = {
+          .data = token.data + colon + 1,
+          .length = token.length - colon - 1,
+      };
+      cycle.device = SC_String_ParseTime(&device, err);
+      if (*err != NO_ERROR) {
+        return;
+      }
+      cycle.io_time = SC_String_ParseTime(&time, err);
+      if (*err != NO_ERROR) {
+        return;
+      }
+      if (cycle.device >= SC_IO_MAX_DEVICES || cycle.io_time == 0 ||
+          cycle.io_time > SC_TIME_MAX - process->io_time) {
+        *err = INVALID_TXT_FILE;
+        return;
+      }
+      process->io_time += cycle.io_time;
+    }
+    tokens++;
   }
 
-  sim->step_length = totalBurstTime;
-  sim->current_step = 0;
-  sim->steps = malloc(sizeof(SC_SimStepState) * totalBurstTime);
-
-  int *remaining_bursts = malloc(sizeof(int) * n);
-  for (int i = 0; i < n; i++) {
-    remaining_bursts[i] = proc_array[i]->burst_time;
+  if (tokens == 0) {
+    *err = EMPTY_STRING;
+    return;
+  }
+  // Processes start and end on the CPU.
+  if (tokens % 2 == 0) {
+    *err = INVALID_TXT_FILE;
+    return;
+  }
+  if (tokens == 1) {
+    return;
   }
 
-  int time = 0;
-  int elapsed_time = 0;
-  float total_waiting_time = 0;
-
-  for (int pidx = 0; pidx < n; pidx++) {
-    SC_Process *proc = proc_array[pidx];
-
-    int waiting_time = elapsed_time - proc->arrival_time;
-    if (waiting_time < 0)
-      waiting_time = 0;
-
-    total_waiting_time += waiting_time;
-
-    for (int b = 0; b < proc->burst_time; b++) {
-      SC_SimStepState *step = &sim->steps[time];
-      step->current_process = proc->pid_idx;
-
-      step->process_length = n;
-      step->processes = malloc(sizeof(SC_Process) * n);
-
-      SC_ProcessList_Node *orig = processes->head;
-      int j = 0;
-      while (orig != NULL) {
-        SC_Process copy = orig->value;
-
-        for (int k = 0; k < n; k++) {
-          if (copy.pid_idx == proc_array[k]->pid_idx) {
-            int adjusted_burst = remaining_bursts[k] - (k == pidx ? 1 : 0);
-            copy.burst_time = adjusted_burst < 0 ? 0 : adjusted_burst;
-            if (k == pidx) {
-              copy.waiting_time = waiting_time;
-            } else {
-              copy.waiting_time = 0;
-            }
-            break;
-          }
-        }
-
-        step->processes[j++] = copy;
-        orig = orig->next;
-      }
+  SC_ProcessTable_AppendCycle(table, cycle, err);
+  if (*err != NO_ERROR) {
+    return;
+  }
+  process->cycle_count = tokens / 2 + 1;
 
-      remaining_bursts[pidx]--;
-      time++;
+  SC_IoCycle *cycles = (SC_IoCycle *)table->cycles.data + process->first_cycle;
+  for (size_t i = 0; i < process->cycle_count; i++) {
+    if (cycles[i].cpu_time == 0) {
+      *err = INVALID_TXT_FILE;
+      return;
     }
+  }
+}
 
-    elapsed_time += proc->burst_time;
+// Parses `buffer` as the value of a column, from the burst time on.
+static void SC_Process_ParseColumn(SC_ProcessTable *table, SC_Process *process,
+                                   int column, SC_String *buffer, SC_Err err) {
+  SC_String_TrimStart(buffer, ' ');
+  if (2 == column) {
+    SC_Process_ParseBursts(table, process, buffer, err);
+    return;
+  }
+  if (4 == column) {
+    int column_value = SC_String_ParseInt(buffer, err);
+    if (*err == NO_ERROR) {
+      process->priority = column_value;
+    }
+    return;
   }
 
-  sim->avg_waiting_time = total_waiting_time / (float)n;
+  SC_Time column_value = SC_String_ParseTime(buffer, err);
+  if (*err != NO_ERROR) {
+    return;
+  }
 
-  free(remaining_bursts);
-  free(proc_array);
+  if (3 == column) {
+    process->arrival_time = column_value;
+  } else if (5 == column) {
+    process->period = column_value;
+  } else if (6 == column) {
+    process->deadline = column_value;
+  } else {
+    *err = INVALID_TXT_FILE;
+  }
 }
 
+/**
+ * Parses a file of `P, burst, arrival, priority` rows.
+ *
+ * Real-time tasks can add `period` and `deadline` columns, like
+ * `T1, 2, 0, 1, 10, 8`. Rows without them run once and have no deadline.
+ * Processes that do I/O list their bursts, see `SC_Process_ParseBursts`.
+ */
 void parse_scheduling_file(SC_String *file_contents,
                            struct SC_Arena *pids_arena,
-                           struct SC_Arena *processes_arena,
-                           SC_StringList *pid_list, SC_ProcessList *processes,
+                           SC_StringList *pid_list, SC_ProcessTable *processes,
                            SC_Err err) {
-  const int b_max_length = 255;
+  // Long enough for the bursts of processes with many I/O cycles.
+  const int b_max_length = 4096;
   char b_data[b_max_length];
   SC_String buffer = {
       .data = b_data,
@@ -1200,19 +6309,18 @@ void parse_scheduling_file(SC_String *file_contents,
     switch (current_char) {
     case '\n': {
 
-      if (4 != current_column) {
+      if (current_column < 4 || current_column > 6) {
         *err = INVALID_TXT_FILE;
         return;
       }
 
-      SC_String_TrimStart(&buffer, ' ');
-      int column_value = SC_String_ParseInt(&buffer, err);
+      SC_Process_ParseColumn(processes, &current_process, current_column,
+                             &buffer, err);
       if (*err != NO_ERROR) {
         return;
       }
-      current_process.priority = column_value;
 
-      SC_ProcessList_Append(processes, processes_arena, current_process, err);
+      SC_ProcessTable_Append(processes, current_process, err);
       if (*err != NO_ERROR) {
         return;
       }
@@ -1236,20 +6344,11 @@ void parse_scheduling_file(SC_String *file_contents,
         }
         current_process.pid_idx = pid_list->count - 1;
       } else {
-        SC_String_TrimStart(&buffer, ' ');
-        int column_value = SC_String_ParseInt(&buffer, err);
+        SC_Process_ParseColumn(processes, &current_process, current_column,
+                               &buffer, err);
         if (*err != NO_ERROR) {
           return;
         }
-
-        if (2 == current_column) {
-          current_process.burst_time = column_value;
-        } else if (3 == current_column) {
-          current_process.arrival_time = column_value;
-        } else {
-          *err = INVALID_TXT_FILE;
-          return;
-        }
       }
 
       buffer.length = 0;
@@ -2140,138 +7239,246 @@ void fill_actions(SC_String *file_contents, struct SC_Arena *sync_arena,
 
 // ##################################
 // #                                #
-// #         MISCELLANEOUS          #
+// #           WORKLOADS            #
 // #                                #
 // ##################################
 
-// Comparison functions
-int compare_by_arrival_time(SC_Process a, SC_Process b) {
-  return (int)a.arrival_time - (int)b.arrival_time;
-}
+typedef enum {
+  /** Independent arrivals, exponential times between them. */
+  SC_ARRIVALS_POISSON,
+  /**
+   * Groups of arrivals close together separated by quiet periods, like
+   * batch jobs or traffic spikes.
+   */
+  SC_ARRIVALS_BURSTY,
+} SC_ArrivalDistribution;
 
-int compare_by_burst_time(SC_Process a, SC_Process b) {
-  return (int)a.burst_time - (int)b.burst_time;
-}
+typedef enum {
+  SC_BURSTS_EXPONENTIAL,
+  /** Heavy tailed, a few processes take most of the CPU time. */
+  SC_BURSTS_PARETO,
+  /** Mostly short interactive processes with some long batch ones. */
+  SC_BURSTS_BIMODAL,
+} SC_BurstDistribution;
 
-int compare_by_priority(SC_Process a, SC_Process b) {
-  return (int)a.priority - (int)b.priority;
+/**
+ * How a workload spreads its arrivals and burst times.
+ */
+typedef struct {
+  SC_ArrivalDistribution arrivals;
+  /** Mean time between arrivals, on bursty workloads only inside a group. */
+  double mean_interarrival;
+  /** Bursty workloads: mean processes per group. */
+  double mean_group_size;
+  /** Bursty workloads: mean time between the end and start of two groups. */
+  double mean_quiet_time;
+
+  SC_BurstDistribution bursts;
+  /** Mean burst time, of the short processes on bimodal workloads. */
+  double mean_burst;
+  /** Pareto workloads: shape of the tail, smaller is heavier. */
+  double pareto_alpha;
+  /** Bimodal workloads: mean burst time of the long processes. */
+  double mean_long_burst;
+  /** Bimodal workloads: fraction of long processes, from 0 to 1. */
+  double long_fraction;
+
+  /** Priorities go from 0 to `max_priority`. */
+  uint max_priority;
+} SC_WorkloadConfig;
+
+/**
+ * A config with Poisson arrivals and exponential bursts that keeps the CPU
+ * around 80% busy.
+ */
+SC_WorkloadConfig SC_WorkloadConfig_Default(void) {
+  return (SC_WorkloadConfig){
+      .arrivals = SC_ARRIVALS_POISSON,
+      .mean_interarrival = 10,
+      .mean_group_size = 20,
+      .mean_quiet_time = 200,
+      .bursts = SC_BURSTS_EXPONENTIAL,
+      .mean_burst = 8,
+      .pareto_alpha = 1.5,
+      .mean_long_burst = 80,
+      .long_fraction = 0.1,
+      .max_priority = 9,
+  };
 }
 
-// Merge sort implementation
-SC_ProcessList_Node *mergedSorted(SC_ProcessList_Node *a,
-                                  SC_ProcessList_Node *b,
-                                  int (*cmp)(SC_Process, SC_Process)) {
-  if (!a)
-    return b;
-  if (!b)
-    return a;
+/**
+ * Generates processes one at a time, in arrival order.
+ *
+ * It only keeps a few counters, so any amount of processes can be generated
+ * and written without holding them in memory.
+ */
+typedef struct {
+  SC_WorkloadConfig config;
+  SC_Random random;
+  SC_Time time;
+  size_t generated;
+  /** Bursty workloads: processes left on the current group. */
+  size_t group_left;
+} SC_Workload;
+
+void SC_Workload_Init(SC_Workload *workload, SC_WorkloadConfig config,
+                      uint64_t seed) {
+  workload->config = config;
+  SC_Random_Init(&workload->random, seed);
+  workload->time = 0;
+  workload->generated = 0;
+  workload->group_left = 0;
+}
 
-  if (cmp(a->value, b->value) <= 0) {
-    a->next = mergedSorted(a->next, b, cmp);
-    return a;
-  } else {
-    b->next = mergedSorted(a, b->next, cmp);
-    return b;
+// Rounds a sampled time to whole time units, at least `min`.
+static SC_Time SC_Workload_ToTime(double value, SC_Time min) {
+  if (!(value < (double)SC_TIME_MAX / 2)) {
+    return SC_TIME_MAX / 2;
   }
+  SC_Time time = (SC_Time)(value + 0.5);
+  return time > min ? time : min;
 }
 
-void splitList(SC_ProcessList_Node *source, SC_ProcessList_Node **front,
-               SC_ProcessList_Node **back) {
-  SC_ProcessList_Node *slow = source;
-  SC_ProcessList_Node *fast = source->next;
-
-  while (fast) {
-    fast = fast->next;
-    if (fast) {
-      slow = slow->next;
-      fast = fast->next;
+static SC_Time SC_Workload_NextGap(SC_Workload *workload) {
+  SC_WorkloadConfig *config = &workload->config;
+  double gap =
+      SC_Random_Exponential(&workload->random, config->mean_interarrival);
+
+  if (config->arrivals == SC_ARRIVALS_BURSTY) {
+    if (workload->group_left == 0) {
+      // Geometric group sizes, with at least one process.
+      double size = SC_Random_Exponential(&workload->random,
+                                          config->mean_group_size);
+      workload->group_left = SC_Workload_ToTime(size, 1);
+      if (workload->generated > 0) {
+        gap += SC_Random_Exponential(&workload->random,
+                                     config->mean_quiet_time);
+      }
     }
+    workload->group_left--;
   }
 
-  *front = source;
-  *back = slow->next;
-  slow->next = NULL;
+  return workload->generated > 0 ? SC_Workload_ToTime(gap, 0) : 0;
 }
 
-void mergeSort(SC_ProcessList_Node **headRef,
-               int (*cmp)(SC_Process, SC_Process)) {
-  SC_ProcessList_Node *head = *headRef;
-  if (!head || !head->next)
-    return;
-
-  SC_ProcessList_Node *a, *b;
-  splitList(head, &a, &b);
-
-  mergeSort(&a, cmp);
-  mergeSort(&b, cmp);
+static SC_Time SC_Workload_NextBurst(SC_Workload *workload) {
+  SC_WorkloadConfig *config = &workload->config;
+  double burst = 0;
+  switch (config->bursts) {
+  case SC_BURSTS_EXPONENTIAL:
+    burst = SC_Random_Exponential(&workload->random, config->mean_burst);
+    break;
+  case SC_BURSTS_PARETO:
+    burst = SC_Random_Pareto(&workload->random, config->mean_burst,
+                             config->pareto_alpha);
+    break;
+  case SC_BURSTS_BIMODAL: {
+    SC_Bool is_long =
+        SC_Random_Uniform(&workload->random) <= config->long_fraction;
+    burst = SC_Random_Exponential(&workload->random,
+                                  is_long ? config->mean_long_burst
+                                          : config->mean_burst);
+  } break;
+  default:
+    SC_PANIC("Unknown burst distribution %d!", config->bursts);
+  }
 
-  *headRef = mergedSorted(a, b, cmp);
+  return SC_Workload_ToTime(burst, 1);
 }
 
-void SC_ProcessList_sort(SC_ProcessList *list,
-                         int (*cmp)(SC_Process, SC_Process)) {
-  mergeSort(&(list->head), cmp);
-
-  SC_ProcessList_Node *curr = list->head;
-  while (curr && curr->next) {
-    curr = curr->next;
-  }
-  list->tail = curr;
+/**
+ * Returns the next process, its `pid_idx` is the amount of processes
+ * generated before it.
+ */
+SC_Process SC_Workload_Next(SC_Workload *workload) {
+  workload->time += SC_Workload_NextGap(workload);
+  SC_Process process = {
+      .pid_idx = workload->generated,
+      .arrival_time = workload->time,
+      .burst_time = SC_Workload_NextBurst(workload),
+      .priority = SC_Random_Next(&workload->random) %
+                  (workload->config.max_priority + 1),
+  };
+  workload->generated++;
+  return process;
 }
 
-// Total burst time
-// Calculates the total bust time of the scheduler process
-int SC_Total_busrt_time(SC_ProcessList *list) {
-  int totalTime = 0;
-  SC_ProcessList_Node *current = list->head;
-  while (current != NULL) {
-    SC_Process proc = current->value;
-    totalTime += proc.burst_time;
-    current = current->next;
+/**
+ * Writes `count` processes on the `P, burst, arrival, priority` format that
+ * `parse_scheduling_file` reads, named `P0`, `P1`...
+ */
+void SC_Workload_WriteScheduling(SC_Workload *workload, size_t count,
+                                 FILE *out, SC_Err err) {
+  for (size_t i = 0; i < count; i++) {
+    SC_Process process = SC_Workload_Next(workload);
+    fprintf(out, "P%zu, %" PRIu64 ", %" PRIu64 ", %u\n", process.pid_idx,
+            process.burst_time, process.arrival_time, process.priority);
   }
 
-  return totalTime;
+  if (ferror(out)) {
+    *err = FILE_WRITE_FAILED;
+  }
 }
 
-// Returns the process with minimun burst time in a step
-SC_Process SC_Verify_AT_BT(SC_ProcessList *list, int step) {
-  SC_ProcessList_sort(list, compare_by_burst_time);
+/**
+ * Writes the three files of a synchronization simulation:
+ *
+ * - `processes`: `count` processes as `name,burst,arrival,priority`.
+ * - `resources`: `resource_count` resources as `name,instances`, with 1 to 3
+ *   instances each.
+ * - `actions`: `actions_per_process` actions of every process as
+ *   `process,action,resource,cycle`, on cycles while the process runs.
+ *
+ * Synchronization simulations count cycles with `int`, keep the workload
+ * under `INT_MAX` time units.
+ */
+void SC_Workload_WriteSync(SC_Workload *workload, size_t count,
+                           size_t resource_count, size_t actions_per_process,
+                           FILE *processes, FILE *resources, FILE *actions,
+                           SC_Err err) {
+  if (resource_count == 0) {
+    resource_count = 1;
+  }
 
-  SC_ProcessList_Node *current = list->head;
+  for (size_t r = 0; r < resource_count; r++) {
+    fprintf(resources, "R%zu,%" PRIu64 "\n", r,
+            1 + SC_Random_Next(&workload->random) % 3);
+  }
 
-  while (current != NULL) {
-    if (current->value.arrival_time <= step && current->value.burst_time != 0) {
-      return current->value;
+  for (size_t i = 0; i < count; i++) {
+    SC_Process process = SC_Workload_Next(workload);
+    fprintf(processes, "P%zu,%" PRIu64 ",%" PRIu64 ",%u\n", process.pid_idx,
+            process.burst_time, process.arrival_time, process.priority);
+
+    for (size_t a = 0; a < actions_per_process; a++) {
+      size_t resource = SC_Random_Next(&workload->random) % resource_count;
+      SC_Time cycle = process.arrival_time +
+                      SC_Random_Next(&workload->random) % process.burst_time;
+      const char *action =
+          SC_Random_Next(&workload->random) % 2 == 0 ? "READ" : "WRITE";
+      fprintf(actions, "P%zu,%s,R%zu,%" PRIu64 "\n", process.pid_idx, action,
+              resource, cycle);
     }
-    current = current->next;
   }
 
-  return current->value;
+  if (ferror(processes) || ferror(resources) || ferror(actions)) {
+    *err = FILE_WRITE_FAILED;
+  }
 }
 
-int compare_proc_ptrAT(const void *a, const void *b) {
-  const SC_Process *proc_a = *(const SC_Process **)a;
-  const SC_Process *proc_b = *(const SC_Process **)b;
-
-  if (proc_a->arrival_time != proc_b->arrival_time)
-    return proc_a->arrival_time - proc_b->arrival_time;
-  return proc_a->pid_idx - proc_b->pid_idx;
-}
+// ##################################
+// #                                #
+// #         MISCELLANEOUS          #
+// #                                #
+// ##################################
 
-int compare_proc_ptrBT(const void *a, const void *b) {
-  const SC_Process *proc_a = *(const SC_Process **)a;
-  const SC_Process *proc_b = *(const SC_Process **)b;
+// Total burst time
+// Calculates the total bust time of the scheduler process
+SC_Time SC_Total_busrt_time(SC_ProcessTable *table) {
+  SC_Time totalTime = 0;
+  for (size_t i = 0; i < table->count; i++) {
+    totalTime += table->burst_time[i];
+  }
 
-  if (proc_a->burst_time != proc_b->burst_time)
-    return proc_a->burst_time - proc_b->burst_time;
-  return proc_a->pid_idx - proc_b->pid_idx;
+  return totalTime;
 }
-
-int compare_proc_ptrP(const void *a, const void *b) {
-  const SC_Process *proc_a = *(const SC_Process **)a;
-  const SC_Process *proc_b = *(const SC_Process **)b;
-
-  if (proc_a->priority != proc_b->priority)
-    return proc_a->priority - proc_b->priority;
-  return proc_a->pid_idx - proc_b->pid_idx;
-}
\ No newline at end of file
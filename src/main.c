@@ -16,6 +16,10 @@
 const static size_t INITIAL_PROCESSES = 15;
 const static size_t INITIAL_RESOURCES = 5;
 const static size_t INITIAL_ACTIONS = 15;
+// Largest quantum tried when sweeping Round Robin quanta.
+const static SC_Time SC_SWEEP_MAX_QUANTUM = 1000;
+// Most CPUs the multi-core simulation can be set to.
+const static int SC_MAX_CPUS = 64;
 
 typedef int SC_Algorithm;
 const static SC_Algorithm SC_FirstInFirstOut = 0;
@@ -23,6 +27,31 @@ const static SC_Algorithm SC_ShortestFirst = 1;
 const static SC_Algorithm SC_ShortestRemaining = 2;
 const static SC_Algorithm SC_RoundRobin = 3;
 const static SC_Algorithm SC_Priority = 4;
+const static SC_Algorithm SC_MultilevelFeedback = 5;
+const static SC_Algorithm SC_CompletelyFair = 6;
+const static SC_Algorithm SC_EarliestDeadline = 7;
+const static SC_Algorithm SC_RateMonotonic = 8;
+const static SC_Algorithm SC_Lottery = 9;
+const static SC_Algorithm SC_Stride = 10;
+const static SC_Algorithm SC_HighestResponseRatio = 11;
+#define SC_ALGORITHM_COUNT 12
+// Algorithms after the built-in ones are the policies of `POLICY_REGISTRY`.
+#define SC_MAX_ALGORITHMS (SC_ALGORITHM_COUNT + SC_MAX_POLICIES)
+// Colon separated paths of the policy plugins to load on start.
+const static char *SC_POLICIES_ENV = "SCHADULER_POLICIES";
+
+// Name of each algorithm on the review table, indexed by `SC_Algorithm`.
+static const char *SC_ALGORITHM_NAMES[SC_ALGORITHM_COUNT] = {
+    "First In First Out", "Shortest First", "Shortest Remaining",
+    "Round Robin",        "Priority",       "MLFQ",
+    "CFS",                "EDF",            "RM",
+    "Lottery",            "Stride",         "HRRN",
+};
+// Quanta of the MLFQ levels when the ones on the UI aren't valid.
+const static size_t SC_DEFAULT_MLFQ_LEVELS = 3;
+const static SC_Time SC_DEFAULT_MLFQ_QUANTUM = 2;
+// Seed of the lottery draws, fixed so reloading a file gives the same run.
+const static uint64_t SC_LOTTERY_SEED = 1;
 
 // ################################
 // ||                            ||
@@ -44,6 +73,18 @@ typedef struct {
 
 typedef struct {
   GtkSpinButton *spin_button;
+  GtkCheckButton *preemptive_check;
+  GtkSpinButton *aging_spin_button;
+  GtkSpinButton *cpu_spin_button;
+  GtkSpinButton *migration_spin_button;
+  GtkSpinButton *switch_cost_spin_button;
+  GtkSpinButton *cache_refill_spin_button;
+  GtkSpinButton *cache_half_life_spin_button;
+  GtkEntry *mlfq_quanta_entry;
+  GtkSpinButton *mlfq_boost_spin_button;
+  GtkSpinButton *cfs_latency_spin_button;
+  GtkSpinButton *cfs_granularity_spin_button;
+  GtkSpinButton *rt_horizon_spin_button;
   GtkWindow *window;
   GListStore *review_store;
 } SC_LoadedNewFileData;
@@ -53,6 +94,54 @@ typedef struct {
   SC_UpdateSimCanvasData update_sim_canvas;
 } SC_GlobalEventData;
 
+/**
+ * Everything a worker thread needs to run one algorithm.
+ *
+ * Each job owns a private copy of the processes, since simulating writes
+ * into them.
+ */
+typedef struct {
+  SC_Algorithm algorithm;
+  int quantum;
+  gboolean preemptive_priority;
+  int aging_interval;
+  // Algorithms run on `simulate_smp` when there's more than one CPU, or
+  // processes do I/O.
+  size_t cpu_count;
+  SC_Time migration_cost;
+  SC_SwitchCost switch_cost;
+  SC_MlfqConfig mlfq;
+  SC_CfsConfig cfs;
+  // Time periodic tasks stop releasing jobs, 0 for a hyperperiod.
+  SC_Time rt_horizon;
+  SC_ProcessTable processes;
+  SC_Simulation *sim;
+  // Only used by Round Robin.
+  SC_RoundRobinHistory *history;
+  size_t err;
+} SC_SimulationJob;
+
+/**
+ * A worker of the quantum sweep.
+ *
+ * Workers take the next point to evaluate from a shared counter, since small
+ * quanta take much longer to simulate than big ones.
+ */
+typedef struct {
+  SC_ProcessTable processes;
+  SC_SwitchCost switch_cost;
+  SC_QuantumSweepPoint *points;
+  size_t count;
+  gint *next_point;
+  size_t err;
+} SC_QuantumSweepJob;
+
+typedef struct {
+  SC_QuantumSweepPoint *points;
+  size_t count;
+  size_t best;
+} SC_QuantumSweepPlotData;
+
 // Syncronization
 
 typedef struct {
@@ -85,9 +174,12 @@ G_DECLARE_FINAL_TYPE(SCProcessGio, sc_process_gio, SC, PROCESS_GIO, GObject)
 struct _SCProcessGio {
   GObject parent_instance;
   size_t pid_idx;
-  uint burst_time;
-  uint arrival_time;
+  SC_Time burst_time;
+  SC_Time arrival_time;
   uint priority;
+  // I/O time left, and whether the process is blocked on it.
+  SC_Time io_time;
+  gboolean blocked;
 };
 static void sc_process_gio_init(SCProcessGio *item) {}
 
@@ -98,13 +190,16 @@ static void sc_process_gio_class_init(SCProcessGioClass *class) {}
 
 G_DEFINE_TYPE(SCProcessGio, sc_process_gio, G_TYPE_OBJECT)
 
-static SCProcessGio *sc_process_gio_new(size_t pid_idx, uint burst_time,
-                                        uint arrival_time, uint priority) {
+static SCProcessGio *sc_process_gio_new(size_t pid_idx, SC_Time burst_time,
+                                        SC_Time arrival_time, uint priority,
+                                        SC_Time io_time, gboolean blocked) {
   SCProcessGio *item = g_object_new(SC_TYPE_PROCESS_GIO, NULL);
   item->pid_idx = pid_idx;
   item->burst_time = burst_time;
   item->arrival_time = arrival_time;
   item->priority = priority;
+  item->io_time = io_time;
+  item->blocked = blocked;
 
   return item;
 }
@@ -112,15 +207,21 @@ static SCProcessGio *sc_process_gio_new(size_t pid_idx, uint burst_time,
 static size_t sc_process_gio_get_pid_idx(SCProcessGio *self) {
   return self->pid_idx;
 }
-static uint sc_process_gio_get_burst_time(SCProcessGio *self) {
+static SC_Time sc_process_gio_get_burst_time(SCProcessGio *self) {
   return self->burst_time;
 }
-static uint sc_process_gio_get_arrival_time(SCProcessGio *self) {
+static SC_Time sc_process_gio_get_arrival_time(SCProcessGio *self) {
   return self->arrival_time;
 }
 static uint sc_process_gio_get_priority(SCProcessGio *self) {
   return self->priority;
 }
+static SC_Time sc_process_gio_get_io_time(SCProcessGio *self) {
+  return self->io_time;
+}
+static gboolean sc_process_gio_get_blocked(SCProcessGio *self) {
+  return self->blocked;
+}
 
 #define SC_TYPE_ALGORITHM_PERFORMANCE (sc_algorithm_performance_get_type())
 G_DECLARE_FINAL_TYPE(SCAlgorithmPerformance, sc_algorithm_performance, SC,
@@ -130,6 +231,22 @@ struct _SCAlgorithmPerformance {
   GObject parent_instance;
   const char *name;
   float avg_waiting_time;
+  float avg_io_waiting_time;
+  float avg_turnaround_time;
+  float avg_response_time;
+  float throughput;
+  float cpu_utilization;
+  float cpu_efficiency;
+  size_t context_switches;
+  size_t migrations;
+  float load_imbalance;
+  float fairness;
+  size_t deadline_misses;
+  SC_Time lateness_max;
+  SC_Time waiting_p50;
+  SC_Time waiting_p90;
+  SC_Time waiting_p99;
+  SC_Time waiting_max;
 };
 static void sc_algorithm_performance_init(SCAlgorithmPerformance *item) {}
 
@@ -141,12 +258,29 @@ sc_algorithm_performance_class_init(SCAlgorithmPerformanceClass *class) {}
 
 G_DEFINE_TYPE(SCAlgorithmPerformance, sc_algorithm_performance, G_TYPE_OBJECT)
 
+// Copies the metrics of a finished simulation.
 static SCAlgorithmPerformance *
-sc_algorithm_performance_new(const char *name, float avg_waiting_time) {
+sc_algorithm_performance_new(const char *name, SC_Simulation *sim) {
   SCAlgorithmPerformance *item =
       g_object_new(SC_TYPE_ALGORITHM_PERFORMANCE, NULL);
   item->name = name;
-  item->avg_waiting_time = avg_waiting_time;
+  item->avg_waiting_time = sim->avg_waiting_time;
+  item->avg_io_waiting_time = sim->avg_io_waiting_time;
+  item->avg_turnaround_time = sim->avg_turnaround_time;
+  item->avg_response_time = sim->avg_response_time;
+  item->throughput = sim->throughput;
+  item->cpu_utilization = sim->cpu_utilization;
+  item->cpu_efficiency = sim->cpu_efficiency;
+  item->context_switches = sim->context_switches;
+  item->migrations = sim->migrations;
+  item->load_imbalance = sim->load_imbalance;
+  item->fairness = sim->fairness;
+  item->deadline_misses = sim->deadline_misses;
+  item->lateness_max = sim->lateness_max;
+  item->waiting_p50 = sim->waiting_p50;
+  item->waiting_p90 = sim->waiting_p90;
+  item->waiting_p99 = sim->waiting_p99;
+  item->waiting_max = sim->waiting_max;
 
   return item;
 }
@@ -155,9 +289,100 @@ static const char *
 sc_algorithm_performance_get_name(SCAlgorithmPerformance *self) {
   return self->name;
 }
-static float
-sc_algorithm_performance_get_avg_waiting_time(SCAlgorithmPerformance *self) {
-  return self->avg_waiting_time;
+
+/**
+ * The metrics shown as columns of the review table.
+ */
+typedef enum {
+  SC_METRIC_AVG_WAITING_TIME,
+  SC_METRIC_AVG_IO_WAITING_TIME,
+  SC_METRIC_WAITING_P50,
+  SC_METRIC_WAITING_P90,
+  SC_METRIC_WAITING_P99,
+  SC_METRIC_WAITING_MAX,
+  SC_METRIC_AVG_TURNAROUND_TIME,
+  SC_METRIC_AVG_RESPONSE_TIME,
+  SC_METRIC_THROUGHPUT,
+  SC_METRIC_CPU_UTILIZATION,
+  SC_METRIC_CPU_EFFICIENCY,
+  SC_METRIC_CONTEXT_SWITCHES,
+  SC_METRIC_MIGRATIONS,
+  SC_METRIC_LOAD_IMBALANCE,
+  SC_METRIC_FAIRNESS,
+  SC_METRIC_DEADLINE_MISSES,
+  SC_METRIC_LATENESS_MAX,
+  SC_METRIC_COUNT,
+} SC_PerformanceMetric;
+
+static const char *SC_PERFORMANCE_METRIC_TITLES[SC_METRIC_COUNT] = {
+    "AVG Waiting Time", "AVG I/O Wait",   "P50 Waiting",
+    "P90 Waiting",      "P99 Waiting",    "Max Waiting",
+    "AVG Turnaround",   "AVG Response",   "Throughput",
+    "CPU Usage",        "CPU Efficiency", "Context Switches",
+    "Migrations",       "Load Imbalance", "Fairness",
+    "Deadline Misses",  "Max Lateness",
+};
+
+// Writes `metric` of `self` into `buff` as the review table shows it.
+static void sc_algorithm_performance_format_metric(SCAlgorithmPerformance *self,
+                                                   SC_PerformanceMetric metric,
+                                                   char *buff, size_t size) {
+  switch (metric) {
+  case SC_METRIC_AVG_WAITING_TIME:
+    snprintf(buff, size, "%.2f", self->avg_waiting_time);
+    break;
+  case SC_METRIC_AVG_IO_WAITING_TIME:
+    snprintf(buff, size, "%.2f", self->avg_io_waiting_time);
+    break;
+  case SC_METRIC_WAITING_P50:
+    snprintf(buff, size, "%" PRIu64, self->waiting_p50);
+    break;
+  case SC_METRIC_WAITING_P90:
+    snprintf(buff, size, "%" PRIu64, self->waiting_p90);
+    break;
+  case SC_METRIC_WAITING_P99:
+    snprintf(buff, size, "%" PRIu64, self->waiting_p99);
+    break;
+  case SC_METRIC_WAITING_MAX:
+    snprintf(buff, size, "%" PRIu64, self->waiting_max);
+    break;
+  case SC_METRIC_AVG_TURNAROUND_TIME:
+    snprintf(buff, size, "%.2f", self->avg_turnaround_time);
+    break;
+  case SC_METRIC_AVG_RESPONSE_TIME:
+    snprintf(buff, size, "%.2f", self->avg_response_time);
+    break;
+  case SC_METRIC_THROUGHPUT:
+    snprintf(buff, size, "%.4f", self->throughput);
+    break;
+  case SC_METRIC_CPU_UTILIZATION:
+    snprintf(buff, size, "%.1f%%", self->cpu_utilization * 100);
+    break;
+  case SC_METRIC_CPU_EFFICIENCY:
+    snprintf(buff, size, "%.1f%%", self->cpu_efficiency * 100);
+    break;
+  case SC_METRIC_CONTEXT_SWITCHES:
+    snprintf(buff, size, "%zu", self->context_switches);
+    break;
+  case SC_METRIC_MIGRATIONS:
+    snprintf(buff, size, "%zu", self->migrations);
+    break;
+  case SC_METRIC_LOAD_IMBALANCE:
+    snprintf(buff, size, "%.1f%%", self->load_imbalance * 100);
+    break;
+  case SC_METRIC_FAIRNESS:
+    snprintf(buff, size, "%.3f", self->fairness);
+    break;
+  case SC_METRIC_DEADLINE_MISSES:
+    snprintf(buff, size, "%zu", self->deadline_misses);
+    break;
+  case SC_METRIC_LATENESS_MAX:
+    snprintf(buff, size, "%" PRIu64, self->lateness_max);
+    break;
+  default:
+    snprintf(buff, size, "-");
+    break;
+  }
 }
 
 // ################################
@@ -172,13 +397,17 @@ static SC_Algorithm SELECTED_ALGORITHM;
 // Arena used to store all data associated with an `SC_Simulation`.
 static struct SC_Arena SIM_ARENA;
 
-static struct SC_Arena PROCESS_LIST_ARENA;
-static SC_ProcessList PROCESS_LIST;
+static SC_ProcessTable PROCESS_TABLE;
 
 static struct SC_Arena PIDS_ARENA;
 static SC_StringList PID_LIST;
 
-static SC_Simulation *SIM_STATES[5] = {0};
+static SC_Simulation *SIM_STATES[SC_MAX_ALGORITHMS] = {0};
+// Policies loaded from plugins, they're shown after the built-in algorithms.
+static SC_PolicyRegistry POLICY_REGISTRY;
+// Checkpoints of the Round Robin simulation, so changing the quantum only
+// simulates from the first slice that changes.
+static SC_RoundRobinHistory RR_HISTORY;
 // static SC_Simulation *SIM_STATE;
 static struct SC_Arena SIM_BTN_LABELS_ARENA;
 
@@ -202,6 +431,19 @@ static SC_SyncSimulator *SYNC_SIM_STATE;
 // ||                            ||
 // ################################
 
+// The built-in algorithms and the loaded policies.
+static int algorithm_count(void) {
+  return SC_ALGORITHM_COUNT + POLICY_REGISTRY.count;
+}
+
+// Name of `algorithm` on the review table.
+static const char *algorithm_name(SC_Algorithm algorithm) {
+  if (algorithm < SC_ALGORITHM_COUNT) {
+    return SC_ALGORITHM_NAMES[algorithm];
+  }
+  return POLICY_REGISTRY.policies[algorithm - SC_ALGORITHM_COUNT]->name;
+}
+
 // Updated the simulation display
 static void update_sim_canvas(SC_UpdateSimCanvasData params, SC_Err err) {
   GtkWidget *widget;
@@ -221,52 +463,99 @@ static void update_sim_canvas(SC_UpdateSimCanvasData params, SC_Err err) {
   sprintf(str + strlen(str), "%zu", current_sim->current_step);
   gtk_label_set_label(params.step_label, str);
 
+  if (current_sim->step_length == 0) {
+    return;
+  }
+
   SC_Arena_Reset(&SIM_BTN_LABELS_ARENA);
-  for (int i = 0; i <= current_sim->current_step; i++) {
-    size_t current_process = current_sim->steps[i].current_process;
-    size_t max = -1;
-
-    size_t pid_idx = 49;
-    char *data = "<N/A>";
-    SC_String pid_str = {
-        .data = data,
-        .length = strlen(data),
-        .data_capacity = strlen(data),
-    };
-    if (current_process != max) {
-      pid_idx = current_sim->steps[i].processes[current_process].pid_idx;
-      pid_str = SC_StringList_GetAt(&PID_LIST, pid_idx, err);
-      if (*err != NO_ERROR) {
-        fprintf(
-            stderr,
-            "SIM_STEP_ERROR (%d): Failed to get pid for process (idx: %zu): "
-            "Failed to get PID from stringlist with idx: %zu\n",
-            i, current_process, pid_idx);
-        return;
-      }
+  // One row per CPU, each with the segments that CPU ran.
+  for (size_t cpu = 0; cpu < current_sim->cpu_count; cpu++) {
+    GtkWidget *cpu_row = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 1);
+    gtk_box_append(params.canvas_container, cpu_row);
+    if (current_sim->cpu_count > 1) {
+      char cpu_text[32];
+      snprintf(cpu_text, sizeof(cpu_text), "CPU %zu", cpu);
+      gtk_box_append(GTK_BOX(cpu_row), gtk_label_new(cpu_text));
     }
 
-    char css_class[] = {'p', 'i', 'd', '_', 0, 0, 0, 0, 0, 0, 0, 0};
-    sprintf(css_class + strlen(css_class), "%zu", pid_idx);
-
-    GtkWidget *label = gtk_label_new(pid_str.data);
-    gtk_box_append(params.canvas_container, label);
-    gtk_widget_add_css_class(label, css_class);
-    gtk_widget_add_css_class(label, "pid_box");
-
-    SC_Bool is_last_iteration = i == current_sim->current_step;
-    if (is_last_iteration) {
-      g_list_store_remove_all(params.info_store);
-      for (int j = 0; j < current_sim->steps[i].process_length; j++) {
-        SC_Process current = current_sim->steps[i].processes[j];
-        fprintf(stderr, "INFO: Appending value to store\n");
-        g_list_store_append(
-            params.info_store,
-            sc_process_gio_new(current.pid_idx, current.burst_time,
-                               current.arrival_time, current.priority));
+    SC_Slice *timeline = &current_sim->timelines[cpu];
+    SC_Segment *segments = timeline->data;
+    for (size_t i = 0; i < timeline->length; i++) {
+      SC_Segment segment = segments[i];
+      if (segment.start > current_sim->current_step) {
+        break;
+      }
+
+      size_t pid_idx = 49;
+      char *data = "<N/A>";
+      SC_String pid_str = {
+          .data = data,
+          .length = strlen(data),
+          .data_capacity = strlen(data),
+      };
+      if (segment.pid_idx != SC_NO_PROCESS) {
+        pid_idx = segment.pid_idx;
+        pid_str = SC_StringList_GetAt(&PID_LIST, pid_idx, err);
+        if (*err != NO_ERROR) {
+          fprintf(stderr,
+                  "SIM_STEP_ERROR (%zu): Failed to get pid for segment: "
+                  "Failed to get PID from stringlist with idx: %zu\n",
+                  i, pid_idx);
+          return;
+        }
       }
+
+      // Only the part of the segment up to the current step is shown.
+      SC_Time end = SC_Time_Min(segment.end, current_sim->current_step + 1);
+      const char *label_format = "%s (%" PRIu64 ")";
+      if (segment.reason == SC_SEGMENT_MIGRATION) {
+        label_format = "%s (migrating %" PRIu64 ")";
+      } else if (segment.reason == SC_SEGMENT_SWITCH) {
+        label_format = "%s (switching %" PRIu64 ")";
+      }
+      char label_text[64];
+      snprintf(label_text, sizeof(label_text), label_format, pid_str.data,
+               end - segment.start);
+
+      char css_class[] = {'p', 'i', 'd', '_', 0, 0, 0, 0, 0, 0, 0, 0};
+      sprintf(css_class + strlen(css_class), "%zu", pid_idx);
+
+      GtkWidget *label = gtk_label_new(label_text);
+      gtk_box_append(GTK_BOX(cpu_row), label);
+      gtk_widget_add_css_class(label, css_class);
+      gtk_widget_add_css_class(label, "pid_box");
     }
   }
+
+  SC_SimStepState step = {0};
+  step.processes = SC_Arena_Alloc(
+      &SIM_BTN_LABELS_ARENA,
+      sizeof(SC_Process) * current_sim->steps.process_length, err);
+  if (*err != NO_ERROR) {
+    fprintf(stderr, "SIM_STEP_ERROR: Failed to allocate the step buffer!\n");
+    return;
+  }
+
+  SC_Simulation_GetStep(current_sim, current_sim->current_step, &step, err);
+  if (*err != NO_ERROR) {
+    fprintf(stderr, "SIM_STEP_ERROR: Failed to rebuild step %zu!\n",
+            current_sim->current_step);
+    return;
+  }
+  g_list_store_remove_all(params.info_store);
+  for (int j = 0; j < step.process_length; j++) {
+    SC_Process current = step.processes[j];
+    // Only simulations that model the I/O take it off the processes.
+    gboolean blocked = NULL != current_sim->blocked_time &&
+                       current.cycle_count > 0 &&
+                       SC_ProcessTable_IsBlocked(&PROCESS_TABLE, j, &current);
+    fprintf(stderr, "INFO: Appending value to store\n");
+    g_list_store_append(
+        params.info_store,
+        sc_process_gio_new(current.pid_idx, current.burst_time,
+                           current.arrival_time, current.priority,
+                           current.io_time, blocked));
+  }
 }
 
 static void sync_update_sim_canvas(SC_SyncUpdateSimCanvas params, SC_Err err) {
@@ -451,10 +740,10 @@ static void bind_burst_time_cb(GtkSignalListItemFactory *factory,
                                GtkListItem *listitem) {
   GtkWidget *label = gtk_list_item_get_child(listitem);
   GObject *item = gtk_list_item_get_item(GTK_LIST_ITEM(listitem));
-  uint time = sc_process_gio_get_burst_time(SC_PROCESS_GIO(item));
+  SC_Time time = sc_process_gio_get_burst_time(SC_PROCESS_GIO(item));
 
-  char buff[10] = {0};
-  sprintf(buff, "%d", time);
+  char buff[21] = {0};
+  sprintf(buff, "%" PRIu64, time);
   gtk_label_set_text(GTK_LABEL(label), buff);
 }
 
@@ -462,10 +751,10 @@ static void bind_arrival_time_cb(GtkSignalListItemFactory *factory,
                                  GtkListItem *listitem) {
   GtkWidget *label = gtk_list_item_get_child(listitem);
   GObject *item = gtk_list_item_get_item(GTK_LIST_ITEM(listitem));
-  uint time = sc_process_gio_get_arrival_time(SC_PROCESS_GIO(item));
+  SC_Time time = sc_process_gio_get_arrival_time(SC_PROCESS_GIO(item));
 
-  char buff[10] = {0};
-  sprintf(buff, "%d", time);
+  char buff[21] = {0};
+  sprintf(buff, "%" PRIu64, time);
   gtk_label_set_text(GTK_LABEL(label), buff);
 }
 
@@ -480,6 +769,19 @@ static void bind_priority_cb(GtkSignalListItemFactory *factory,
   gtk_label_set_text(GTK_LABEL(label), buff);
 }
 
+static void bind_io_time_cb(GtkSignalListItemFactory *factory,
+                            GtkListItem *listitem) {
+  GtkWidget *label = gtk_list_item_get_child(listitem);
+  GObject *item = gtk_list_item_get_item(GTK_LIST_ITEM(listitem));
+  SC_Time time = sc_process_gio_get_io_time(SC_PROCESS_GIO(item));
+  gboolean blocked = sc_process_gio_get_blocked(SC_PROCESS_GIO(item));
+
+  char buff[32] = {0};
+  snprintf(buff, sizeof(buff), blocked ? "%" PRIu64 " (blocked)" : "%" PRIu64,
+           time);
+  gtk_label_set_text(GTK_LABEL(label), buff);
+}
+
 static void bind_algorithm_name_cb(GtkSignalListItemFactory *factory,
                                    GtkListItem *listitem) {
   GtkWidget *label = gtk_list_item_get_child(listitem);
@@ -490,15 +792,16 @@ static void bind_algorithm_name_cb(GtkSignalListItemFactory *factory,
   gtk_label_set_text(GTK_LABEL(label), name);
 }
 
-static void bind_avg_waiting_time_cb(GtkSignalListItemFactory *factory,
-                                     GtkListItem *listitem) {
+// `data` is the `SC_PerformanceMetric` of the column.
+static void bind_performance_metric_cb(GtkSignalListItemFactory *factory,
+                                       GtkListItem *listitem, gpointer data) {
   GtkWidget *label = gtk_list_item_get_child(listitem);
   GObject *item = gtk_list_item_get_item(GTK_LIST_ITEM(listitem));
-  float waiting_time = sc_algorithm_performance_get_avg_waiting_time(
-      SC_ALGORITHM_PERFORMANCE(item));
+  SC_PerformanceMetric metric = GPOINTER_TO_INT(data);
 
-  char buff[10] = {0};
-  sprintf(buff, "%.2f", waiting_time);
+  char buff[32] = {0};
+  sc_algorithm_performance_format_metric(SC_ALGORITHM_PERFORMANCE(item), metric,
+                                         buff, sizeof(buff));
   gtk_label_set_text(GTK_LABEL(label), buff);
 }
 
@@ -508,66 +811,696 @@ static void bind_avg_waiting_time_cb(GtkSignalListItemFactory *factory,
 // ||                            ||
 // ################################
 
-static void change_algorithm_to_first_in_first_out(GtkCheckButton *self,
-                                                   gpointer *data) {
+// Selects the algorithm of the check button, stored as its "algorithm".
+static void change_algorithm(GtkCheckButton *self, gpointer *data) {
+  // The button that was unchecked is notified too.
+  if (!gtk_check_button_get_active(self)) {
+    return;
+  }
+
   size_t err = NO_ERROR;
   SC_GlobalEventData *ev_data = (SC_GlobalEventData *)data;
-  SELECTED_ALGORITHM = SC_FirstInFirstOut;
+  SELECTED_ALGORITHM =
+      GPOINTER_TO_INT(g_object_get_data(G_OBJECT(self), "algorithm"));
   update_sim_canvas(ev_data->update_sim_canvas, &err);
 }
 
-static void change_algorithm_to_shortest_first(GtkCheckButton *self,
-                                               gpointer *data) {
+// What switching processes costs with the selected settings.
+static SC_SwitchCost selected_switch_cost(SC_LoadedNewFileData *ev_data) {
+  return (SC_SwitchCost){
+      .switch_cost =
+          gtk_spin_button_get_value_as_int(ev_data->switch_cost_spin_button),
+      .cache_refill =
+          gtk_spin_button_get_value_as_int(ev_data->cache_refill_spin_button),
+      .cache_half_life = gtk_spin_button_get_value_as_int(
+          ev_data->cache_half_life_spin_button),
+  };
+}
+
+/**
+ * A job that runs `algorithm` on `sim` with the settings currently selected
+ * on the UI. Its processes are left empty.
+ *
+ * Widgets can only be read from the main thread.
+ */
+static SC_SimulationJob selected_simulation_job(SC_LoadedNewFileData *ev_data,
+                                                SC_Algorithm algorithm,
+                                                SC_Simulation *sim) {
+  SC_Time boost_interval =
+      gtk_spin_button_get_value_as_int(ev_data->mlfq_boost_spin_button);
+  SC_MlfqConfig mlfq = SC_MlfqConfig_Doubling(
+      SC_DEFAULT_MLFQ_LEVELS, SC_DEFAULT_MLFQ_QUANTUM, boost_interval);
+  const char *quanta =
+      gtk_editable_get_text(GTK_EDITABLE(ev_data->mlfq_quanta_entry));
   size_t err = NO_ERROR;
+  SC_MlfqConfig_ParseQuanta(&mlfq, quanta, &err);
+  if (err != NO_ERROR) {
+    fprintf(stderr, "WARN: Invalid MLFQ quanta `%s`, using the default!\n",
+            quanta);
+  }
+
+  return (SC_SimulationJob){
+      .algorithm = algorithm,
+      .quantum = gtk_spin_button_get_value_as_int(ev_data->spin_button),
+      .preemptive_priority =
+          gtk_check_button_get_active(ev_data->preemptive_check),
+      .aging_interval =
+          gtk_spin_button_get_value_as_int(ev_data->aging_spin_button),
+      .cpu_count = gtk_spin_button_get_value_as_int(ev_data->cpu_spin_button),
+      .migration_cost =
+          gtk_spin_button_get_value_as_int(ev_data->migration_spin_button),
+      .switch_cost = selected_switch_cost(ev_data),
+      .mlfq = mlfq,
+      .cfs =
+          {
+              .target_latency = gtk_spin_button_get_value_as_int(
+                  ev_data->cfs_latency_spin_button),
+              .min_granularity = gtk_spin_button_get_value_as_int(
+                  ev_data->cfs_granularity_spin_button),
+          },
+      .rt_horizon =
+          gtk_spin_button_get_value_as_int(ev_data->rt_horizon_spin_button),
+      .sim = sim,
+      .history = &RR_HISTORY,
+      .err = NO_ERROR,
+  };
+}
+
+static gpointer run_simulation_job(gpointer data);
+
+/**
+ * Simulates `algorithm` again on the main thread with the selected settings.
+ */
+static void simulate_selected(SC_LoadedNewFileData *ev_data,
+                              SC_Algorithm algorithm, SC_Err err) {
+  SC_SimulationJob job =
+      selected_simulation_job(ev_data, algorithm, SIM_STATES[algorithm]);
+  // The UI's processes are used directly, nothing else simulates them now.
+  job.processes = PROCESS_TABLE;
+  run_simulation_job(&job);
+  *err = job.err;
+}
+
+static void handle_quantum_updated(GtkSpinButton *self, gpointer *data) {
   SC_GlobalEventData *ev_data = (SC_GlobalEventData *)data;
-  SELECTED_ALGORITHM = SC_ShortestFirst;
+
+  if (NULL == SIM_STATES[SC_RoundRobin]) {
+    fprintf(stderr, "INFO: Skipping rerendering because state is null\n");
+    return;
+  }
+
+  fprintf(stderr, "INFO: Rerendering based on new quantum...\n");
+  int quantum = gtk_spin_button_get_value_as_int(self);
+  if (quantum <= 0) {
+    SC_RoundRobinHistory_Reset(&RR_HISTORY);
+  }
+
+  // Every algorithm that takes turns of a quantum.
+  SC_Algorithm algorithms[] = {SC_RoundRobin, SC_Lottery, SC_Stride};
+  for (int i = 0; i < 3; i++) {
+    size_t err = NO_ERROR;
+    SC_Simulation *sim = SIM_STATES[algorithms[i]];
+    // Round Robin reuses the checkpoints of its last run.
+    if (quantum <= 0 || algorithms[i] != SC_RoundRobin) {
+      SC_Simulation_Deinit(sim);
+    }
+    if (quantum > 0) {
+      simulate_selected(&ev_data->new_file_loaded, algorithms[i], &err);
+    }
+    if (err != NO_ERROR) {
+      fprintf(stderr, "ERROR: %s\n", SC_Err_ToString(&err));
+      return;
+    }
+
+    if (sim->current_step >= sim->step_length) {
+      sim->current_step = 0;
+    }
+  }
+
+  size_t err = NO_ERROR;
   update_sim_canvas(ev_data->update_sim_canvas, &err);
 }
 
-static void change_algorithm_to_shortest_remaining(GtkCheckButton *self,
-                                                   gpointer *data) {
+// The policy `simulate_smp` uses to run the job's algorithm.
+static SC_SmpPolicy simulation_job_smp_policy(SC_SimulationJob *job) {
+  switch (job->algorithm) {
+  case SC_ShortestFirst:
+    return SC_SMP_SHORTEST_FIRST;
+  case SC_ShortestRemaining:
+    return SC_SMP_SHORTEST_REMAINING;
+  case SC_RoundRobin:
+    return SC_SMP_ROUND_ROBIN;
+  case SC_Priority:
+    return job->preemptive_priority ? SC_SMP_PRIORITY_PREEMPTIVE
+                                    : SC_SMP_PRIORITY;
+  case SC_FirstInFirstOut:
+  default:
+    return SC_SMP_FIFO;
+  }
+}
+
+/**
+ * Runs the job's algorithm, it's the entry point of the worker threads.
+ */
+static gpointer run_simulation_job(gpointer data) {
+  SC_SimulationJob *job = (SC_SimulationJob *)data;
+  job->sim->switch_cost = job->switch_cost;
+
+  // Only the algorithms up to Priority run on several CPUs or model I/O, the
+  // rest see the CPU bursts of a process as a single one.
+  if ((job->cpu_count > 1 || SC_ProcessTable_HasIo(&job->processes)) &&
+      job->algorithm <= SC_Priority) {
+    SC_SmpConfig config = {
+        .policy = simulation_job_smp_policy(job),
+        .cpu_count = job->cpu_count,
+        .quantum = job->quantum,
+        .migration_cost = job->migration_cost,
+    };
+    // The Round Robin checkpoints only hold single CPU runs.
+    if (NULL != job->history && job->algorithm == SC_RoundRobin) {
+      SC_RoundRobinHistory_Reset(job->history);
+    }
+    SC_Simulation_Deinit(job->sim);
+    simulate_smp(&job->processes, job->sim, &config, &job->err);
+    return NULL;
+  }
+
+  switch (job->algorithm) {
+  case SC_FirstInFirstOut: {
+    simulate_first_in_first_out(&job->processes, job->sim, &job->err);
+  } break;
+  case SC_ShortestFirst: {
+    simulate_shortest_first(&job->processes, job->sim, &job->err);
+  } break;
+  case SC_ShortestRemaining: {
+    simulate_shortest_remaining(&job->processes, job->sim, &job->err);
+  } break;
+  case SC_RoundRobin: {
+    simulate_round_robin_incremental(&job->processes, job->sim, job->history,
+                                     job->quantum, &job->err);
+  } break;
+  case SC_Priority: {
+    if (job->preemptive_priority) {
+      simulate_priority_preemptive(&job->processes, job->sim,
+                                   job->aging_interval, &job->err);
+    } else {
+      simulate_priority(&job->processes, job->sim, &job->err);
+    }
+  } break;
+  case SC_MultilevelFeedback: {
+    simulate_multilevel_feedback(&job->processes, job->sim, &job->mlfq,
+                                 &job->err);
+  } break;
+  case SC_CompletelyFair: {
+    simulate_completely_fair(&job->processes, job->sim, &job->cfs, &job->err);
+  } break;
+  case SC_EarliestDeadline:
+  case SC_RateMonotonic: {
+    SC_RtPolicy policy = job->algorithm == SC_EarliestDeadline
+                             ? SC_RT_EARLIEST_DEADLINE
+                             : SC_RT_RATE_MONOTONIC;
+    SC_RtConfig config = SC_RtConfig_Default(policy, &job->processes);
+    if (job->rt_horizon > 0) {
+      config.horizon = job->rt_horizon;
+    }
+    simulate_real_time(&job->processes, job->sim, &config, &job->err);
+  } break;
+  // Like Round Robin, they aren't simulated until there's a quantum.
+  case SC_Lottery: {
+    if (job->quantum > 0) {
+      simulate_lottery(&job->processes, job->sim, job->quantum,
+                       SC_LOTTERY_SEED, &job->err);
+    }
+  } break;
+  case SC_Stride: {
+    if (job->quantum > 0) {
+      simulate_stride(&job->processes, job->sim, job->quantum, &job->err);
+    }
+  } break;
+  case SC_HighestResponseRatio: {
+    simulate_highest_response_ratio(&job->processes, job->sim, &job->err);
+  } break;
+  default: {
+    if (job->algorithm < SC_ALGORITHM_COUNT ||
+        job->algorithm >= algorithm_count()) {
+      SC_PANIC("FATAL: Unrecognized scheduling algorithm (%d)!",
+               job->algorithm);
+    }
+    const SC_Policy *policy =
+        POLICY_REGISTRY.policies[job->algorithm - SC_ALGORITHM_COUNT];
+    simulate_policy(&job->processes, job->sim, policy, &job->err);
+  } break;
+  }
+
+  return NULL;
+}
+
+static gpointer run_quantum_sweep_job(gpointer data) {
+  SC_QuantumSweepJob *job = (SC_QuantumSweepJob *)data;
+
+  for (;;) {
+    size_t i = g_atomic_int_add(job->next_point, 1);
+    if (i >= job->count) {
+      break;
+    }
+
+    SC_RoundRobin_Evaluate(&job->processes, &job->switch_cost,
+                           &job->points[i], &job->err);
+    if (job->err != NO_ERROR) {
+      break;
+    }
+  }
+
+  return NULL;
+}
+
+static void free_quantum_sweep_plot(gpointer data) {
+  SC_QuantumSweepPlotData *plot = (SC_QuantumSweepPlotData *)data;
+  free(plot->points);
+  free(plot);
+}
+
+/**
+ * Plots every metric of the sweep against the quantum.
+ *
+ * Each metric is scaled to its own maximum, so the plot compares the shape of
+ * the curves rather than their values.
+ */
+static void draw_quantum_sweep(GtkDrawingArea *area, cairo_t *cr, int width,
+                               int height, gpointer data) {
+  SC_QuantumSweepPlotData *plot = (SC_QuantumSweepPlotData *)data;
+  const double margin = 30;
+  const double plot_width = width - margin * 2;
+  const double plot_height = height - margin * 2;
+  if (plot->count == 0 || plot_width <= 0 || plot_height <= 0) {
+    return;
+  }
+
+  double max_values[4] = {0};
+  for (size_t i = 0; i < plot->count; i++) {
+    SC_QuantumSweepPoint *point = &plot->points[i];
+    max_values[0] = MAX(max_values[0], point->avg_waiting_time);
+    max_values[1] = MAX(max_values[1], point->avg_turnaround_time);
+    max_values[2] = MAX(max_values[2], point->context_switches);
+    max_values[3] = MAX(max_values[3], point->cpu_efficiency);
+  }
+
+  const char *names[4] = {"AVG Waiting Time", "AVG Turnaround Time",
+                          "Context Switches", "CPU Efficiency"};
+  const double colors[4][3] = {{0.86, 0.27, 0.27},
+                               {0.27, 0.47, 0.86},
+                               {0.27, 0.70, 0.35},
+                               {0.80, 0.60, 0.20}};
+
+  // Axes
+  cairo_set_source_rgb(cr, 0.5, 0.5, 0.5);
+  cairo_set_line_width(cr, 1);
+  cairo_move_to(cr, margin, margin);
+  cairo_line_to(cr, margin, margin + plot_height);
+  cairo_line_to(cr, margin + plot_width, margin + plot_height);
+  cairo_stroke(cr);
+
+  double span = plot->count > 1 ? plot->count - 1 : 1;
+  double best_x = margin + plot->best / span * plot_width;
+  cairo_move_to(cr, best_x, margin);
+  cairo_line_to(cr, best_x, margin + plot_height);
+  cairo_stroke(cr);
+
+  char buff[32];
+  snprintf(buff, sizeof(buff), "%d", plot->points[0].quantum);
+  cairo_move_to(cr, margin, height - margin / 3);
+  cairo_show_text(cr, buff);
+  snprintf(buff, sizeof(buff), "%d", plot->points[plot->count - 1].quantum);
+  cairo_move_to(cr, margin + plot_width - 20, height - margin / 3);
+  cairo_show_text(cr, buff);
+
+  cairo_set_line_width(cr, 2);
+  for (int m = 0; m < 4; m++) {
+    cairo_set_source_rgb(cr, colors[m][0], colors[m][1], colors[m][2]);
+    cairo_move_to(cr, margin + 10 + m * 150, margin / 2);
+    cairo_show_text(cr, names[m]);
+
+    for (size_t i = 0; i < plot->count; i++) {
+      SC_QuantumSweepPoint *point = &plot->points[i];
+      double value = m == 0   ? point->avg_waiting_time
+                     : m == 1 ? point->avg_turnaround_time
+                     : m == 2 ? point->context_switches
+                              : point->cpu_efficiency;
+      double x = margin + i / span * plot_width;
+      double y = margin + plot_height;
+      if (max_values[m] > 0) {
+        y -= value / max_values[m] * plot_height;
+      }
+
+      if (i == 0) {
+        cairo_move_to(cr, x, y);
+      } else {
+        cairo_line_to(cr, x, y);
+      }
+    }
+    cairo_stroke(cr);
+  }
+}
+
+/**
+ * Shows the plot of a finished sweep, the window takes ownership of `points`.
+ */
+static void show_quantum_sweep_window(GtkWidget *parent_widget,
+                                      SC_QuantumSweepPoint *points,
+                                      size_t count, size_t best) {
+  SC_QuantumSweepPlotData *plot = malloc(sizeof(SC_QuantumSweepPlotData));
+  if (NULL == plot) {
+    fprintf(stderr, "ERROR: Failed to allocate the quantum sweep plot!\n");
+    free(points);
+    return;
+  }
+  *plot = (SC_QuantumSweepPlotData){
+      .points = points,
+      .count = count,
+      .best = best,
+  };
+
+  GtkWidget *parent_window = GTK_WIDGET(gtk_widget_get_root(parent_widget));
+  GtkWidget *window = gtk_window_new();
+  gtk_window_set_title(GTK_WINDOW(window), "Quantum Sweep");
+  gtk_window_set_transient_for(GTK_WINDOW(window), GTK_WINDOW(parent_window));
+  gtk_window_set_default_size(GTK_WINDOW(window), 640, 420);
+
+  GtkWidget *content_box = gtk_box_new(GTK_ORIENTATION_VERTICAL, 10);
+  gtk_window_set_child(GTK_WINDOW(window), content_box);
+
+  char buff[256];
+  snprintf(buff, sizeof(buff),
+           "Best quantum: %d (AVG waiting %.2f, AVG turnaround %.2f, %zu "
+           "context switches)",
+           points[best].quantum, points[best].avg_waiting_time,
+           points[best].avg_turnaround_time, points[best].context_switches);
+  GtkWidget *label = gtk_label_new(buff);
+  gtk_label_set_wrap(GTK_LABEL(label), TRUE);
+  gtk_box_append(GTK_BOX(content_box), label);
+
+  GtkWidget *area = gtk_drawing_area_new();
+  gtk_widget_set_vexpand(area, TRUE);
+  gtk_drawing_area_set_draw_func(GTK_DRAWING_AREA(area), draw_quantum_sweep,
+                                 plot, free_quantum_sweep_plot);
+  gtk_box_append(GTK_BOX(content_box), area);
+
+  gtk_window_present(GTK_WINDOW(window));
+}
+
+/**
+ * Simulates Round Robin with every quantum from 1 up to the longest burst
+ * (capped at `SC_SWEEP_MAX_QUANTUM`) in parallel, plots the results and
+ * selects the best quantum.
+ *
+ * Any quantum at least as long as the longest burst gives the same schedule,
+ * so bigger ones aren't tried.
+ */
+static void handle_quantum_sweep_click(GtkWidget *widget, gpointer data) {
+  SC_GlobalEventData *ev_data = (SC_GlobalEventData *)data;
+
+  if (PROCESS_TABLE.count == 0) {
+    show_alert_dialog(widget, "Quantum Sweep",
+                      "Load a file before sweeping the quantum!");
+    return;
+  }
+
+  SC_Time max_quantum = SC_ProcessTable_MaxBurstTime(&PROCESS_TABLE);
+  if (max_quantum > SC_SWEEP_MAX_QUANTUM) {
+    max_quantum = SC_SWEEP_MAX_QUANTUM;
+  }
+  size_t count = max_quantum > 0 ? max_quantum : 1;
+
+  size_t worker_count = g_get_num_processors();
+  if (worker_count > count) {
+    worker_count = count;
+  }
+
+  SC_QuantumSweepPoint *points = malloc(sizeof(SC_QuantumSweepPoint) * count);
+  SC_QuantumSweepJob *jobs = calloc(worker_count, sizeof(SC_QuantumSweepJob));
+  GThread **workers = calloc(worker_count, sizeof(GThread *));
+  if (NULL == points || NULL == jobs || NULL == workers) {
+    fprintf(stderr, "ERROR: Failed to allocate the quantum sweep!\n");
+    free(points);
+    free(jobs);
+    free(workers);
+    return;
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    points[i] = (SC_QuantumSweepPoint){.quantum = i + 1};
+  }
+
+  fprintf(stderr, "INFO: Sweeping %zu quanta on %zu workers...\n", count,
+          worker_count);
+  gint next_point = 0;
   size_t err = NO_ERROR;
+  for (size_t i = 0; i < worker_count; i++) {
+    jobs[i] = (SC_QuantumSweepJob){
+        .switch_cost = selected_switch_cost(&ev_data->new_file_loaded),
+        .points = points,
+        .count = count,
+        .next_point = &next_point,
+        .err = NO_ERROR,
+    };
+    SC_ProcessTable_Copy(&jobs[i].processes, &PROCESS_TABLE, &jobs[i].err);
+    if (jobs[i].err != NO_ERROR) {
+      continue;
+    }
+
+    workers[i] = g_thread_try_new("quantum-sweep", run_quantum_sweep_job,
+                                  &jobs[i], NULL);
+  }
+
+  // Sweeps on this thread if the first worker couldn't be started.
+  if (NULL == workers[0] && jobs[0].err == NO_ERROR) {
+    run_quantum_sweep_job(&jobs[0]);
+  }
+
+  for (size_t i = 0; i < worker_count; i++) {
+    if (NULL != workers[i]) {
+      g_thread_join(workers[i]);
+    }
+    SC_ProcessTable_Deinit(&jobs[i].processes);
+    if (jobs[i].err != NO_ERROR) {
+      err = jobs[i].err;
+    }
+  }
+  free(jobs);
+  free(workers);
+
+  if (err != NO_ERROR || (size_t)g_atomic_int_get(&next_point) < count) {
+    fprintf(stderr, "ERROR: Quantum sweep failed: %s\n",
+            SC_Err_ToString(&err));
+    show_alert_dialog(widget, "Quantum Sweep", "The quantum sweep failed!");
+    free(points);
+    return;
+  }
+
+  size_t best = SC_QuantumSweep_Best(points, count);
+  int best_quantum = points[best].quantum;
+  fprintf(stderr, "INFO: Best quantum is %d\n", best_quantum);
+  show_quantum_sweep_window(widget, points, count, best);
+
+  // Rerenders Round Robin with the best quantum.
+  gtk_spin_button_set_value(ev_data->new_file_loaded.spin_button,
+                            best_quantum);
+}
+
+static void handle_priority_settings_updated(GtkWidget *self,
+                                             gpointer *data) {
   SC_GlobalEventData *ev_data = (SC_GlobalEventData *)data;
-  SELECTED_ALGORITHM = SC_ShortestRemaining;
+
+  if (NULL == SIM_STATES[SC_Priority]) {
+    fprintf(stderr, "INFO: Skipping rerendering because state is null\n");
+    return;
+  }
+
+  fprintf(stderr, "INFO: Rerendering based on new priority settings...\n");
+  size_t err = NO_ERROR;
+  SC_Simulation_Deinit(SIM_STATES[SC_Priority]);
+  simulate_selected(&ev_data->new_file_loaded, SC_Priority, &err);
+  if (err != NO_ERROR) {
+    fprintf(stderr, "ERROR: %s\n", SC_Err_ToString(&err));
+    return;
+  }
+
   update_sim_canvas(ev_data->update_sim_canvas, &err);
 }
 
-static void change_algorithm_to_round_robin(GtkCheckButton *self,
-                                            gpointer *data) {
+/**
+ * Simulates every algorithm on its own thread with the selected settings and
+ * shows their metrics on the review table.
+ */
+static void simulate_all_algorithms(SC_GlobalEventData *global_ev_data) {
+  SC_LoadedNewFileData *ev_data = &global_ev_data->new_file_loaded;
   size_t err = NO_ERROR;
+
+  g_list_store_remove_all(ev_data->review_store);
+  for (int i = 0; i < algorithm_count(); i++) {
+    if (NULL != SIM_STATES[i]) {
+      SC_Simulation_Deinit(SIM_STATES[i]);
+    }
+  }
+  SC_Arena_Reset(&SIM_ARENA);
+  SC_RoundRobinHistory_Reset(&RR_HISTORY);
+
+  SC_RtSchedulability schedulability =
+      SC_Rt_CheckSchedulability(&PROCESS_TABLE);
+  if (schedulability.task_count > 0) {
+    fprintf(stderr,
+            "INFO: %zu periodic tasks use %.1f%% of the CPU. EDF %s and RM %s "
+            "meet every deadline.\n",
+            schedulability.task_count, schedulability.utilization * 100,
+            schedulability.edf_schedulable ? "will" : "may not",
+            schedulability.rate_monotonic_schedulable ? "will" : "may not");
+  }
+
+  SC_SimulationJob jobs[SC_MAX_ALGORITHMS] = {0};
+  GThread *workers[SC_MAX_ALGORITHMS] = {0};
+  for (int i = 0; i < algorithm_count(); i++) {
+    SIM_STATES[i] = SC_Arena_Alloc(&SIM_ARENA, sizeof(SC_Simulation), &err);
+    if (err != NO_ERROR) {
+      fprintf(stderr, "ERROR: %s\n", SC_Err_ToString(&err));
+      exit(1);
+    }
+    *SIM_STATES[i] = (SC_Simulation){0};
+
+    jobs[i] = selected_simulation_job(ev_data, i, SIM_STATES[i]);
+    SC_ProcessTable_Copy(&jobs[i].processes, &PROCESS_TABLE, &err);
+    if (err != NO_ERROR) {
+      fprintf(stderr, "ERROR: %s\n", SC_Err_ToString(&err));
+      exit(1);
+    }
+  }
+
+  for (int i = 0; i < algorithm_count(); i++) {
+    workers[i] =
+        g_thread_try_new("simulation", run_simulation_job, &jobs[i], NULL);
+    if (NULL == workers[i]) {
+      fprintf(stderr, "WARN: Failed to start worker, simulating inline!\n");
+      run_simulation_job(&jobs[i]);
+    }
+  }
+
+  for (int i = 0; i < algorithm_count(); i++) {
+    if (NULL != workers[i]) {
+      g_thread_join(workers[i]);
+    }
+    SC_ProcessTable_Deinit(&jobs[i].processes);
+
+    if (jobs[i].err != NO_ERROR) {
+      fprintf(stderr, "ERROR: %s\n", SC_Err_ToString(&jobs[i].err));
+      exit(1);
+    }
+
+    g_list_store_append(
+        ev_data->review_store,
+        sc_algorithm_performance_new(algorithm_name(i), SIM_STATES[i]));
+    SIM_STATES[i]->current_step = 0;
+  }
+
+  update_sim_canvas(global_ev_data->update_sim_canvas, &err);
+  if (err != NO_ERROR) {
+    return;
+  }
+}
+
+static void handle_mlfq_settings_updated(GtkWidget *self, gpointer *data) {
   SC_GlobalEventData *ev_data = (SC_GlobalEventData *)data;
-  SELECTED_ALGORITHM = SC_RoundRobin;
+
+  if (NULL == SIM_STATES[SC_MultilevelFeedback]) {
+    fprintf(stderr, "INFO: Skipping rerendering because state is null\n");
+    return;
+  }
+
+  fprintf(stderr, "INFO: Rerendering based on new MLFQ settings...\n");
+  size_t err = NO_ERROR;
+  SC_Simulation *sim = SIM_STATES[SC_MultilevelFeedback];
+  SC_Simulation_Deinit(sim);
+  simulate_selected(&ev_data->new_file_loaded, SC_MultilevelFeedback, &err);
+  if (err != NO_ERROR) {
+    fprintf(stderr, "ERROR: %s\n", SC_Err_ToString(&err));
+    return;
+  }
+
+  if (sim->current_step >= sim->step_length) {
+    sim->current_step = 0;
+  }
+
   update_sim_canvas(ev_data->update_sim_canvas, &err);
 }
 
-static void change_algorithm_to_priority(GtkCheckButton *self, gpointer *data) {
-  size_t err = NO_ERROR;
+static void handle_cfs_settings_updated(GtkSpinButton *self, gpointer *data) {
   SC_GlobalEventData *ev_data = (SC_GlobalEventData *)data;
-  SELECTED_ALGORITHM = SC_Priority;
+
+  if (NULL == SIM_STATES[SC_CompletelyFair]) {
+    fprintf(stderr, "INFO: Skipping rerendering because state is null\n");
+    return;
+  }
+
+  fprintf(stderr, "INFO: Rerendering based on new CFS settings...\n");
+  size_t err = NO_ERROR;
+  SC_Simulation *sim = SIM_STATES[SC_CompletelyFair];
+  SC_Simulation_Deinit(sim);
+  simulate_selected(&ev_data->new_file_loaded, SC_CompletelyFair, &err);
+  if (err != NO_ERROR) {
+    fprintf(stderr, "ERROR: %s\n", SC_Err_ToString(&err));
+    return;
+  }
+
+  if (sim->current_step >= sim->step_length) {
+    sim->current_step = 0;
+  }
+
   update_sim_canvas(ev_data->update_sim_canvas, &err);
 }
 
-static void handle_quantum_updated(GtkSpinButton *self, gpointer *data) {
+static void handle_rt_settings_updated(GtkSpinButton *self, gpointer *data) {
   SC_GlobalEventData *ev_data = (SC_GlobalEventData *)data;
 
-  if (NULL == SIM_STATES[SC_RoundRobin]) {
+  if (NULL == SIM_STATES[SC_EarliestDeadline] ||
+      NULL == SIM_STATES[SC_RateMonotonic]) {
     fprintf(stderr, "INFO: Skipping rerendering because state is null\n");
     return;
   }
 
-  fprintf(stderr, "INFO: Rerendering based on new quantum...\n");
-  int quantum = gtk_spin_button_get_value_as_int(self);
-  SIM_STATES[SC_RoundRobin]->current_step = 0;
-  simulate_round_robin(&PROCESS_LIST, SIM_STATES[SC_RoundRobin], quantum);
+  fprintf(stderr, "INFO: Rerendering based on new real-time settings...\n");
+  SC_Algorithm algorithms[] = {SC_EarliestDeadline, SC_RateMonotonic};
+  for (int i = 0; i < 2; i++) {
+    size_t err = NO_ERROR;
+    SC_Simulation *sim = SIM_STATES[algorithms[i]];
+    SC_Simulation_Deinit(sim);
+    simulate_selected(&ev_data->new_file_loaded, algorithms[i], &err);
+    if (err != NO_ERROR) {
+      fprintf(stderr, "ERROR: %s\n", SC_Err_ToString(&err));
+      return;
+    }
+
+    if (sim->current_step >= sim->step_length) {
+      sim->current_step = 0;
+    }
+  }
 
   size_t err = NO_ERROR;
   update_sim_canvas(ev_data->update_sim_canvas, &err);
 }
 
+static void handle_cpu_settings_updated(GtkSpinButton *self, gpointer *data) {
+  SC_GlobalEventData *ev_data = (SC_GlobalEventData *)data;
+
+  if (NULL == SIM_STATES[0]) {
+    fprintf(stderr, "INFO: Skipping rerendering because state is null\n");
+    return;
+  }
+
+  fprintf(stderr, "INFO: Rerendering based on new CPU settings...\n");
+  simulate_all_algorithms(ev_data);
+}
+
 static void file_dialog_finished(GObject *source_object, GAsyncResult *res,
                                  gpointer data) {
   SC_GlobalEventData *global_ev_data = (SC_GlobalEventData *)data;
-  SC_LoadedNewFileData ev_data = global_ev_data->new_file_loaded;
 
   GError **error = NULL;
   GFile *file =
@@ -601,101 +1534,19 @@ static void file_dialog_finished(GObject *source_object, GAsyncResult *res,
           file_contents.data);
 
   SC_Arena_Reset(&PIDS_ARENA);
-  SC_Arena_Reset(&PROCESS_LIST_ARENA);
   SC_StringList_Reset(&PID_LIST);
-  SC_ProcessList_Reset(&PROCESS_LIST);
+  SC_ProcessTable_Reset(&PROCESS_TABLE);
 
   size_t err = NO_ERROR;
-  parse_scheduling_file(&file_contents, &PIDS_ARENA, &PROCESS_LIST_ARENA,
-                        &PID_LIST, &PROCESS_LIST, &err);
+  parse_scheduling_file(&file_contents, &PIDS_ARENA, &PID_LIST,
+                        &PROCESS_TABLE, &err);
   if (err != NO_ERROR) {
     fprintf(stderr, "ERROR: %s\n", SC_Err_ToString(&err));
   } else {
     fprintf(stderr, "Correctly parsed the file!\n");
   }
 
-  size_t total_processes = PROCESS_LIST.count;
-  size_t total_steps = 0;
-  struct SC_ProcessList_Node *current = PROCESS_LIST.head;
-  for (size_t i = 0; i < total_processes; i++) {
-    total_steps += current->value.burst_time;
-    current = current->next;
-  }
-
-  g_list_store_remove_all(ev_data.review_store);
-  int quantum = gtk_spin_button_get_value_as_int(ev_data.spin_button);
-  SC_Arena_Reset(&SIM_ARENA);
-  for (int i = 0; i < 5; i++) {
-    SIM_STATES[i] = SC_Arena_Alloc(&SIM_ARENA, sizeof(SC_Simulation), &err);
-    if (err != NO_ERROR) {
-      fprintf(stderr, "ERROR: %s\n", SC_Err_ToString(&err));
-      exit(1);
-    }
-
-    SIM_STATES[i]->steps =
-        SC_Arena_Alloc(&SIM_ARENA, sizeof(SC_SimStepState) * total_steps, &err);
-    if (err != NO_ERROR) {
-      fprintf(stderr, "ERROR: %s\n", SC_Err_ToString(&err));
-      exit(1);
-    }
-
-    for (size_t j = 0; j < total_steps; j++) {
-      SIM_STATES[i]->steps[j].processes = SC_Arena_Alloc(
-          &SIM_ARENA, sizeof(SC_Process) * total_processes, &err);
-      if (err != NO_ERROR) {
-        fprintf(stderr, "ERROR: %s\n", SC_Err_ToString(&err));
-        exit(1);
-      }
-      SIM_STATES[i]->steps[j].process_length = total_processes;
-    }
-    SIM_STATES[i]->step_length = total_steps;
-
-    switch (i) {
-    case SC_FirstInFirstOut: {
-      simulate_first_in_first_out(&PROCESS_LIST, SIM_STATES[i]);
-      g_list_store_append(
-          ev_data.review_store,
-          sc_algorithm_performance_new("First In First Out",
-                                       SIM_STATES[i]->avg_waiting_time));
-    } break;
-    case SC_ShortestFirst: {
-      simulate_shortest_first(&PROCESS_LIST, SIM_STATES[i]);
-      g_list_store_append(
-          ev_data.review_store,
-          sc_algorithm_performance_new("Shortest First",
-                                       SIM_STATES[i]->avg_waiting_time));
-    } break;
-    case SC_ShortestRemaining: {
-      simulate_shortest_remaining(&PROCESS_LIST, SIM_STATES[i]);
-      g_list_store_append(
-          ev_data.review_store,
-          sc_algorithm_performance_new("Shortest Remaining",
-                                       SIM_STATES[i]->avg_waiting_time));
-    } break;
-    case SC_RoundRobin: {
-      simulate_round_robin(&PROCESS_LIST, SIM_STATES[i], quantum);
-      g_list_store_append(ev_data.review_store,
-                          sc_algorithm_performance_new(
-                              "Round Robin", SIM_STATES[i]->avg_waiting_time));
-    } break;
-    case SC_Priority: {
-      simulate_priority(&PROCESS_LIST, SIM_STATES[i]);
-      g_list_store_append(ev_data.review_store,
-                          sc_algorithm_performance_new(
-                              "Priority", SIM_STATES[i]->avg_waiting_time));
-    } break;
-    default: {
-      SC_PANIC("FATAL: Unrecognized scheduling algorithm (%d)!", i);
-    } break;
-    }
-
-    SIM_STATES[i]->current_step = 0;
-  }
-
-  update_sim_canvas(global_ev_data->update_sim_canvas, &err);
-  if (err != NO_ERROR) {
-    return;
-  }
+  simulate_all_algorithms(global_ev_data);
 }
 
 static void handle_open_file_click(GtkWidget *widget, gpointer data) {
@@ -1054,7 +1905,8 @@ static GtkWidget *CalendarView(GtkWindow *window) {
   gtk_widget_set_hexpand(processBoxScroller, TRUE);
   gtk_box_append(GTK_BOX(simBox), processBoxScroller);
 
-  GtkWidget *processBox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 1);
+  // Holds one row per CPU.
+  GtkWidget *processBox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 1);
   evData->update_sim_canvas.canvas_container = GTK_BOX(processBox);
 
   gtk_widget_set_hexpand(processBox, TRUE);
@@ -1081,7 +1933,7 @@ static GtkWidget *CalendarView(GtkWindow *window) {
   GListStore *processStore = g_list_store_new(G_TYPE_OBJECT);
   evData->update_sim_canvas.info_store = processStore;
 
-  g_list_store_append(processStore, sc_process_gio_new(0, 0, 0, 0));
+  g_list_store_append(processStore, sc_process_gio_new(0, 0, 0, 0, 0, FALSE));
   fprintf(stderr, "INFO: Creating selection model...\n");
   GtkNoSelection *selectionModel =
       gtk_no_selection_new(G_LIST_MODEL(processStore));
@@ -1122,6 +1974,13 @@ static GtkWidget *CalendarView(GtkWindow *window) {
   col = gtk_column_view_column_new("Priority", factory);
   gtk_column_view_append_column(GTK_COLUMN_VIEW(tableView), col);
 
+  // I/O time column setup
+  factory = gtk_signal_list_item_factory_new();
+  g_signal_connect(factory, "setup", G_CALLBACK(setup_label_cb), NULL);
+  g_signal_connect(factory, "bind", G_CALLBACK(bind_io_time_cb), NULL);
+  col = gtk_column_view_column_new("I/O Time", factory);
+  gtk_column_view_append_column(GTK_COLUMN_VIEW(tableView), col);
+
   // Algorithm selection and load new file half
   GtkWidget *controlsContainer = gtk_box_new(GTK_ORIENTATION_VERTICAL, 5);
   gtk_widget_set_name(controlsContainer, "controlsContainer");
@@ -1140,38 +1999,39 @@ static GtkWidget *CalendarView(GtkWindow *window) {
   GListStore *reviewStore = g_list_store_new(G_TYPE_OBJECT);
   evData->new_file_loaded.review_store = reviewStore;
 
-  const char *algoNames[] = {
-      "First In First Out", "Shortest Job First", "Shortest Remaining Time",
-      "Round Robin",        "Priority",
+  const char *algoNames[SC_ALGORITHM_COUNT] = {
+      "First In First Out",
+      "Shortest Job First",
+      "Shortest Remaining Time",
+      "Round Robin",
+      "Priority",
+      "Multi-Level Feedback Queue",
+      "Completely Fair Scheduler",
+      "Earliest Deadline First",
+      "Rate Monotonic",
+      "Lottery",
+      "Stride",
+      "Highest Response Ratio Next",
   };
   GtkWidget *group = gtk_check_button_new();
-  for (int i = 0; i < 5; i++) {
-    GtkWidget *checkBox = gtk_check_button_new_with_label(algoNames[i]);
+  for (int i = 0; i < algorithm_count(); i++) {
+    const char *label =
+        i < SC_ALGORITHM_COUNT ? algoNames[i] : algorithm_name(i);
+    GtkWidget *checkBox = gtk_check_button_new_with_label(label);
     gtk_box_append(GTK_BOX(algorithmSelectionContainer), checkBox);
     gtk_check_button_set_group(GTK_CHECK_BUTTON(checkBox),
                                GTK_CHECK_BUTTON(group));
+    g_object_set_data(G_OBJECT(checkBox), "algorithm", GINT_TO_POINTER(i));
+    g_signal_connect(checkBox, "toggled", G_CALLBACK(change_algorithm),
+                     evData);
     if (i == 0) {
-      g_signal_connect(checkBox, "toggled",
-                       G_CALLBACK(change_algorithm_to_first_in_first_out),
-                       evData);
       gtk_check_button_set_active(GTK_CHECK_BUTTON(checkBox), TRUE);
-    } else if (i == 1) {
-      g_signal_connect(checkBox, "toggled",
-                       G_CALLBACK(change_algorithm_to_shortest_first), evData);
-    } else if (i == 2) {
-      g_signal_connect(checkBox, "toggled",
-                       G_CALLBACK(change_algorithm_to_shortest_remaining),
-                       evData);
-    } else if (i == 3) {
-      g_signal_connect(checkBox, "toggled",
-                       G_CALLBACK(change_algorithm_to_round_robin), evData);
-    } else if (i == 4) {
-      g_signal_connect(checkBox, "toggled",
-                       G_CALLBACK(change_algorithm_to_priority), evData);
     }
   }
 
-  g_list_store_append(reviewStore, sc_algorithm_performance_new("TEST", 5.0));
+  g_list_store_append(reviewStore,
+                      sc_algorithm_performance_new(
+                          "TEST", &(SC_Simulation){.avg_waiting_time = 5.0}));
   GtkNoSelection *reviewStoreSelectionModel =
       gtk_no_selection_new(G_LIST_MODEL(reviewStore));
   GtkWidget *reviewTable =
@@ -1187,12 +2047,15 @@ static GtkWidget *CalendarView(GtkWindow *window) {
   gtk_column_view_column_set_expand(col, TRUE);
   gtk_column_view_append_column(GTK_COLUMN_VIEW(reviewTable), col);
 
-  // AVG Waiting time setup
-  factory = gtk_signal_list_item_factory_new();
-  g_signal_connect(factory, "setup", G_CALLBACK(setup_label_cb), NULL);
-  g_signal_connect(factory, "bind", G_CALLBACK(bind_avg_waiting_time_cb), NULL);
-  col = gtk_column_view_column_new("AVG Waiting Time", factory);
-  gtk_column_view_append_column(GTK_COLUMN_VIEW(reviewTable), col);
+  // One column per metric
+  for (int i = 0; i < SC_METRIC_COUNT; i++) {
+    factory = gtk_signal_list_item_factory_new();
+    g_signal_connect(factory, "setup", G_CALLBACK(setup_label_cb), NULL);
+    g_signal_connect(factory, "bind", G_CALLBACK(bind_performance_metric_cb),
+                     GINT_TO_POINTER(i));
+    col = gtk_column_view_column_new(SC_PERFORMANCE_METRIC_TITLES[i], factory);
+    gtk_column_view_append_column(GTK_COLUMN_VIEW(reviewTable), col);
+  }
 
   GtkWidget *loadFileContainer = gtk_box_new(GTK_ORIENTATION_VERTICAL, 30);
   gtk_widget_set_name(loadFileContainer, "loadFileContainer");
@@ -1206,6 +2069,102 @@ static GtkWidget *CalendarView(GtkWindow *window) {
   g_signal_connect(quantumEntry, "value-changed",
                    G_CALLBACK(handle_quantum_updated), evData);
 
+  GtkWidget *preemptiveCheck =
+      gtk_check_button_new_with_label("Preemptive Priority");
+  gtk_widget_set_valign(preemptiveCheck, GTK_ALIGN_CENTER);
+  evData->new_file_loaded.preemptive_check = GTK_CHECK_BUTTON(preemptiveCheck);
+  g_signal_connect(preemptiveCheck, "toggled",
+                   G_CALLBACK(handle_priority_settings_updated), evData);
+
+  // An aging interval of 0 disables aging.
+  GtkWidget *agingEntry = gtk_spin_button_new_with_range(0, 1000, 1);
+  gtk_widget_set_valign(agingEntry, GTK_ALIGN_CENTER);
+  evData->new_file_loaded.aging_spin_button = GTK_SPIN_BUTTON(agingEntry);
+  g_signal_connect(agingEntry, "value-changed",
+                   G_CALLBACK(handle_priority_settings_updated), evData);
+
+  // Comma separated quantum of each MLFQ level.
+  GtkWidget *mlfqQuantaEntry = gtk_entry_new();
+  gtk_editable_set_text(GTK_EDITABLE(mlfqQuantaEntry), "2,4,8");
+  gtk_widget_set_valign(mlfqQuantaEntry, GTK_ALIGN_CENTER);
+  evData->new_file_loaded.mlfq_quanta_entry = GTK_ENTRY(mlfqQuantaEntry);
+  g_signal_connect(mlfqQuantaEntry, "activate",
+                   G_CALLBACK(handle_mlfq_settings_updated), evData);
+
+  // A boost interval of 0 disables boosts.
+  GtkWidget *mlfqBoostEntry = gtk_spin_button_new_with_range(0, 10000, 1);
+  gtk_spin_button_set_value(GTK_SPIN_BUTTON(mlfqBoostEntry), 100);
+  gtk_widget_set_valign(mlfqBoostEntry, GTK_ALIGN_CENTER);
+  evData->new_file_loaded.mlfq_boost_spin_button =
+      GTK_SPIN_BUTTON(mlfqBoostEntry);
+  g_signal_connect(mlfqBoostEntry, "value-changed",
+                   G_CALLBACK(handle_mlfq_settings_updated), evData);
+
+  SC_CfsConfig cfsDefaults = SC_CfsConfig_Default();
+  GtkWidget *cfsLatencyEntry = gtk_spin_button_new_with_range(1, 10000, 1);
+  gtk_spin_button_set_value(GTK_SPIN_BUTTON(cfsLatencyEntry),
+                            cfsDefaults.target_latency);
+  gtk_widget_set_valign(cfsLatencyEntry, GTK_ALIGN_CENTER);
+  evData->new_file_loaded.cfs_latency_spin_button =
+      GTK_SPIN_BUTTON(cfsLatencyEntry);
+  g_signal_connect(cfsLatencyEntry, "value-changed",
+                   G_CALLBACK(handle_cfs_settings_updated), evData);
+
+  GtkWidget *cfsGranularityEntry = gtk_spin_button_new_with_range(1, 1000, 1);
+  gtk_spin_button_set_value(GTK_SPIN_BUTTON(cfsGranularityEntry),
+                            cfsDefaults.min_granularity);
+  gtk_widget_set_valign(cfsGranularityEntry, GTK_ALIGN_CENTER);
+  evData->new_file_loaded.cfs_granularity_spin_button =
+      GTK_SPIN_BUTTON(cfsGranularityEntry);
+  g_signal_connect(cfsGranularityEntry, "value-changed",
+                   G_CALLBACK(handle_cfs_settings_updated), evData);
+
+  // Time periodic tasks stop releasing jobs, 0 simulates a hyperperiod.
+  GtkWidget *rtHorizonEntry =
+      gtk_spin_button_new_with_range(0, SC_RT_MAX_DEFAULT_HORIZON, 1);
+  gtk_widget_set_valign(rtHorizonEntry, GTK_ALIGN_CENTER);
+  evData->new_file_loaded.rt_horizon_spin_button =
+      GTK_SPIN_BUTTON(rtHorizonEntry);
+  g_signal_connect(rtHorizonEntry, "value-changed",
+                   G_CALLBACK(handle_rt_settings_updated), evData);
+
+  GtkWidget *cpuEntry = gtk_spin_button_new_with_range(1, SC_MAX_CPUS, 1);
+  gtk_widget_set_valign(cpuEntry, GTK_ALIGN_CENTER);
+  evData->new_file_loaded.cpu_spin_button = GTK_SPIN_BUTTON(cpuEntry);
+  g_signal_connect(cpuEntry, "value-changed",
+                   G_CALLBACK(handle_cpu_settings_updated), evData);
+
+  // Time a process spends moving to another CPU before it runs again.
+  GtkWidget *migrationEntry = gtk_spin_button_new_with_range(0, 1000, 1);
+  gtk_widget_set_valign(migrationEntry, GTK_ALIGN_CENTER);
+  evData->new_file_loaded.migration_spin_button =
+      GTK_SPIN_BUTTON(migrationEntry);
+  g_signal_connect(migrationEntry, "value-changed",
+                   G_CALLBACK(handle_cpu_settings_updated), evData);
+
+  // What a CPU pays to switch to another process, 0 makes switches free.
+  GtkWidget *switchCostEntry = gtk_spin_button_new_with_range(0, 1000, 1);
+  gtk_widget_set_valign(switchCostEntry, GTK_ALIGN_CENTER);
+  evData->new_file_loaded.switch_cost_spin_button =
+      GTK_SPIN_BUTTON(switchCostEntry);
+  g_signal_connect(switchCostEntry, "value-changed",
+                   G_CALLBACK(handle_cpu_settings_updated), evData);
+
+  GtkWidget *cacheRefillEntry = gtk_spin_button_new_with_range(0, 1000, 1);
+  gtk_widget_set_valign(cacheRefillEntry, GTK_ALIGN_CENTER);
+  evData->new_file_loaded.cache_refill_spin_button =
+      GTK_SPIN_BUTTON(cacheRefillEntry);
+  g_signal_connect(cacheRefillEntry, "value-changed",
+                   G_CALLBACK(handle_cpu_settings_updated), evData);
+
+  // A half-life of 0 refills the whole cache on every switch.
+  GtkWidget *cacheHalfLifeEntry = gtk_spin_button_new_with_range(0, 10000, 1);
+  gtk_widget_set_valign(cacheHalfLifeEntry, GTK_ALIGN_CENTER);
+  evData->new_file_loaded.cache_half_life_spin_button =
+      GTK_SPIN_BUTTON(cacheHalfLifeEntry);
+  g_signal_connect(cacheHalfLifeEntry, "value-changed",
+                   G_CALLBACK(handle_cpu_settings_updated), evData);
+
   GtkWidget *backButton = MainButton("Back", handle_previous_click, evData);
   gtk_box_append(GTK_BOX(simControlsBox), backButton);
   // GtkWidget *ppButton = MainButton("Pause/Play", NULL, NULL);
@@ -1222,6 +2181,33 @@ static GtkWidget *CalendarView(GtkWindow *window) {
 
   gtk_box_append(GTK_BOX(loadFileContainer), quantumEntry);
 
+  GtkWidget *sweepBtn =
+      MainButton("Sweep Quantum", handle_quantum_sweep_click, evData);
+  gtk_widget_set_valign(sweepBtn, GTK_ALIGN_CENTER);
+  gtk_box_append(GTK_BOX(loadFileContainer), sweepBtn);
+  gtk_box_append(GTK_BOX(loadFileContainer), preemptiveCheck);
+  gtk_box_append(GTK_BOX(loadFileContainer), agingEntry);
+  gtk_box_append(GTK_BOX(loadFileContainer), gtk_label_new("MLFQ Quanta"));
+  gtk_box_append(GTK_BOX(loadFileContainer), mlfqQuantaEntry);
+  gtk_box_append(GTK_BOX(loadFileContainer), gtk_label_new("MLFQ Boost"));
+  gtk_box_append(GTK_BOX(loadFileContainer), mlfqBoostEntry);
+  gtk_box_append(GTK_BOX(loadFileContainer), gtk_label_new("CFS Latency"));
+  gtk_box_append(GTK_BOX(loadFileContainer), cfsLatencyEntry);
+  gtk_box_append(GTK_BOX(loadFileContainer), gtk_label_new("CFS Granularity"));
+  gtk_box_append(GTK_BOX(loadFileContainer), cfsGranularityEntry);
+  gtk_box_append(GTK_BOX(loadFileContainer), gtk_label_new("RT Horizon"));
+  gtk_box_append(GTK_BOX(loadFileContainer), rtHorizonEntry);
+  gtk_box_append(GTK_BOX(loadFileContainer), gtk_label_new("CPUs"));
+  gtk_box_append(GTK_BOX(loadFileContainer), cpuEntry);
+  gtk_box_append(GTK_BOX(loadFileContainer), gtk_label_new("Migration Cost"));
+  gtk_box_append(GTK_BOX(loadFileContainer), migrationEntry);
+  gtk_box_append(GTK_BOX(loadFileContainer), gtk_label_new("Switch Cost"));
+  gtk_box_append(GTK_BOX(loadFileContainer), switchCostEntry);
+  gtk_box_append(GTK_BOX(loadFileContainer), gtk_label_new("Cache Refill"));
+  gtk_box_append(GTK_BOX(loadFileContainer), cacheRefillEntry);
+  gtk_box_append(GTK_BOX(loadFileContainer), gtk_label_new("Cache Half-Life"));
+  gtk_box_append(GTK_BOX(loadFileContainer), cacheHalfLifeEntry);
+
   return container;
 }
 
@@ -1450,14 +2436,12 @@ static void activate(GtkApplication *app, gpointer user_data) {
 }
 
 int main(int argc, char **argv) {
-  SC_ProcessList_Init(&PROCESS_LIST);
   SC_StringList_Init(&PID_LIST);
 
   size_t err = NO_ERROR;
-  SC_Arena_Init(&PROCESS_LIST_ARENA, sizeof(SC_Process) * INITIAL_PROCESSES,
-                &err);
+  SC_ProcessTable_Init(&PROCESS_TABLE, INITIAL_PROCESSES, &err);
   if (err != NO_ERROR) {
-    fprintf(stderr, "FATAL: Failed to initialize process arena!\n");
+    fprintf(stderr, "FATAL: Failed to initialize process table!\n");
     return 1;
   }
 
@@ -1466,19 +2450,34 @@ int main(int argc, char **argv) {
                 &err);
   if (err != NO_ERROR) {
     fprintf(stderr, "FATAL: Failed to initialize pids arena!\n");
-    SC_Arena_Deinit(&PROCESS_LIST_ARENA);
+    SC_ProcessTable_Deinit(&PROCESS_TABLE);
     return 1;
   }
 
-  SC_Arena_Init(
-      &SIM_ARENA,
-      sizeof(SC_Simulation) +
-          (sizeof(SC_SimStepState) + sizeof(SC_Process) * INITIAL_PROCESSES) *
-              INITIAL_PROCESSES * 5,
-      &err);
+  // Plugins that fail to load are skipped, the built-in algorithms still run.
+  SC_PolicyRegistry_Init(&POLICY_REGISTRY);
+  const char *plugins = getenv(SC_POLICIES_ENV);
+  while (NULL != plugins && *plugins != 0) {
+    size_t length = strcspn(plugins, ":");
+    char path[4096];
+    snprintf(path, sizeof(path), "%.*s", (int)length, plugins);
+    plugins += plugins[length] == ':' ? length + 1 : length;
+    if (length == 0) {
+      continue;
+    }
+
+    SC_PolicyRegistry_Load(&POLICY_REGISTRY, path, &err);
+    if (err != NO_ERROR) {
+      fprintf(stderr, "WARN: Skipping policy plugin: %s\n",
+              POLICY_REGISTRY.load_error);
+      err = NO_ERROR;
+    }
+  }
+
+  SC_Arena_Init(&SIM_ARENA, sizeof(SC_Simulation) * algorithm_count(), &err);
   if (err != NO_ERROR) {
     fprintf(stderr, "FATAL: Failed to initialize simulation arena!\n");
-    SC_Arena_Deinit(&PROCESS_LIST_ARENA);
+    SC_ProcessTable_Deinit(&PROCESS_TABLE);
     SC_Arena_Deinit(&PIDS_ARENA);
     return 1;
   }
@@ -1487,12 +2486,22 @@ int main(int argc, char **argv) {
                 &err);
   if (err != NO_ERROR) {
     fprintf(stderr, "FATAL: Failed to initialize btn labels arena!\n");
-    SC_Arena_Deinit(&PROCESS_LIST_ARENA);
+    SC_ProcessTable_Deinit(&PROCESS_TABLE);
     SC_Arena_Deinit(&PIDS_ARENA);
     SC_Arena_Deinit(&SIM_ARENA);
     return 1;
   }
 
+  SC_RoundRobinHistory_Init(&RR_HISTORY, &err);
+  if (err != NO_ERROR) {
+    fprintf(stderr, "FATAL: Failed to initialize round robin history!\n");
+    SC_ProcessTable_Deinit(&PROCESS_TABLE);
+    SC_Arena_Deinit(&PIDS_ARENA);
+    SC_Arena_Deinit(&SIM_ARENA);
+    SC_Arena_Deinit(&SIM_BTN_LABELS_ARENA);
+    return 1;
+  }
+
   // Syncronization
 
   SC_StringList_Init(&SYNC_PROCESS_NAMES);
@@ -1507,7 +2516,7 @@ int main(int argc, char **argv) {
                 &err);
   if (err != NO_ERROR) {
     fprintf(stderr, "FATAL: Failed to initialize pids arena!\n");
-    SC_Arena_Deinit(&PROCESS_LIST_ARENA);
+    SC_ProcessTable_Deinit(&PROCESS_TABLE);
     return 1;
   }
 
@@ -1519,10 +2528,11 @@ int main(int argc, char **argv) {
   GdkDisplay *display = gdk_display_get_default();
   if (display == NULL) {
     fprintf(stderr, "FATAL: No GDK display found!\n");
-    SC_Arena_Deinit(&PROCESS_LIST_ARENA);
+    SC_ProcessTable_Deinit(&PROCESS_TABLE);
     SC_Arena_Deinit(&PIDS_ARENA);
     SC_Arena_Deinit(&SIM_ARENA);
     SC_Arena_Deinit(&SIM_BTN_LABELS_ARENA);
+    SC_RoundRobinHistory_Deinit(&RR_HISTORY);
     return 1;
   }
 
@@ -1544,8 +2554,17 @@ int main(int argc, char **argv) {
     }
   }
 
+  fprintf(stderr, "INFO: deiniting simulation steps\n");
+  for (int i = 0; i < algorithm_count(); i++) {
+    if (NULL != SIM_STATES[i]) {
+      SC_Simulation_Deinit(SIM_STATES[i]);
+    }
+  }
+  SC_RoundRobinHistory_Deinit(&RR_HISTORY);
+  SC_PolicyRegistry_Deinit(&POLICY_REGISTRY);
+
   fprintf(stderr, "INFO: deiniting all arenas\n");
-  SC_Arena_Deinit(&PROCESS_LIST_ARENA);
+  SC_ProcessTable_Deinit(&PROCESS_TABLE);
   SC_Arena_Deinit(&PIDS_ARENA);
   SC_Arena_Deinit(&SIM_ARENA);
   SC_Arena_Deinit(&SIM_BTN_LABELS_ARENA);
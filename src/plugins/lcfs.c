@@ -0,0 +1,101 @@
+#include "../policy.h"
+#include <stdlib.h>
+
+// An example scheduling policy plugin: preemptive Last Come First Served.
+//
+// The newest process always runs, a process that arrives takes the CPU from
+// the running one and the preempted process resumes once everyone who came
+// after it is done.
+//
+// Build it with `./nob -p` and load it with `./build/cli -P ./build/lcfs.so`,
+// or with `SCHADULER_POLICIES=./build/lcfs.so ./build/main`.
+
+/**
+ * The ready processes, the one that arrived last on top.
+ */
+typedef struct {
+  size_t *slots;
+  size_t length;
+} SC_LcfsStack;
+
+static void SC_Lcfs_Init(SC_PolicyState *state, SC_Err err) {
+  SC_LcfsStack *stack = malloc(sizeof(SC_LcfsStack));
+  if (NULL == stack) {
+    *err = MALLOC_FAILED;
+    return;
+  }
+
+  size_t n = state->count;
+  stack->slots = malloc(sizeof(size_t) * (n > 0 ? n : 1));
+  if (NULL == stack->slots) {
+    free(stack);
+    *err = MALLOC_FAILED;
+    return;
+  }
+  stack->length = 0;
+  state->data = stack;
+}
+
+static void SC_Lcfs_Deinit(SC_PolicyState *state) {
+  SC_LcfsStack *stack = state->data;
+  if (NULL == stack) {
+    return;
+  }
+
+  free(stack->slots);
+  free(stack);
+  state->data = NULL;
+}
+
+// Processes are admitted in the order they arrive, so the newest goes on top.
+static void SC_Lcfs_Admit(SC_PolicyState *state, size_t slot, SC_Time time,
+                          SC_Err err) {
+  SC_LcfsStack *stack = state->data;
+  stack->slots[stack->length++] = slot;
+}
+
+static size_t SC_Lcfs_PickNext(SC_PolicyState *state, SC_Time time) {
+  SC_LcfsStack *stack = state->data;
+  return stack->length > 0 ? stack->slots[--stack->length] : SC_NO_SLOT;
+}
+
+static SC_Time SC_Lcfs_OnTick(SC_PolicyState *state, size_t slot,
+                              SC_Time time) {
+  return SC_TIME_MAX;
+}
+
+// The preempted process goes under the ones that arrived after it.
+static void SC_Lcfs_OnPreempt(SC_PolicyState *state, size_t slot,
+                              SC_Time time, SC_Err err) {
+  SC_LcfsStack *stack = state->data;
+  const SC_Time *arrival_time = state->arrival_time;
+
+  size_t i = stack->length++;
+  for (; i > 0 && arrival_time[stack->slots[i - 1]] > arrival_time[slot]; i--) {
+    stack->slots[i] = stack->slots[i - 1];
+  }
+  stack->slots[i] = slot;
+}
+
+static SC_Bool SC_Lcfs_Preempts(SC_PolicyState *state, size_t running,
+                                SC_Time time) {
+  SC_LcfsStack *stack = state->data;
+  const SC_Time *arrival_time = state->arrival_time;
+  return stack->length > 0 &&
+         arrival_time[stack->slots[stack->length - 1]] >
+             arrival_time[running];
+}
+
+static const SC_Policy SC_LCFS_POLICY = {
+    .name = "lcfs",
+    .ignores_arrivals = SC_FALSE,
+    .init = SC_Lcfs_Init,
+    .deinit = SC_Lcfs_Deinit,
+    .admit = SC_Lcfs_Admit,
+    .pick_next = SC_Lcfs_PickNext,
+    .on_tick = SC_Lcfs_OnTick,
+    .on_preempt = SC_Lcfs_OnPreempt,
+    .preempts = SC_Lcfs_Preempts,
+};
+
+SC_POLICY_PLUGIN(&SC_LCFS_POLICY);
@@ -0,0 +1,125 @@
+#ifndef SC_POLICY_H
+#define SC_POLICY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// What scheduling policy plugins build against. `lib.c` includes it too, so
+// a plugin only includes this header and doesn't carry a copy of the
+// library.
+
+// ################################
+// ||                            ||
+// ||           TYPES            ||
+// ||                            ||
+// ################################
+
+// Time units used by the scheduling simulations.
+typedef uint64_t SC_Time;
+static const SC_Time SC_TIME_MAX = UINT64_MAX;
+
+typedef int SC_Bool;
+static const SC_Bool SC_TRUE = 1;
+static const SC_Bool SC_FALSE = 0;
+
+// Used when there's no slot to point to.
+static const size_t SC_NO_SLOT = -1;
+
+typedef size_t *SC_Err;
+static const size_t NO_ERROR = 1;
+static const size_t NOT_FOUND = 2;
+static const size_t MALLOC_FAILED = 3;
+static const size_t ARENA_ALLOC_NO_SPACE = 4;
+static const size_t OUT_OF_BOUNDS = 5;
+static const size_t EMPTY_STRING = 6;
+static const size_t INVALID_STRING = 7;
+static const size_t INVALID_TXT_FILE = 8;
+static const size_t RESOURCE_NOT_FOUND = 9;
+static const size_t PROCESS_NOT_FOUND = 10;
+static const size_t SLICE_EXPANSION_FAILED = 11;
+static const size_t FILE_WRITE_FAILED = 12;
+static const size_t INVALID_POLICY = 13;
+static const size_t POLICY_LOAD_FAILED = 14;
+
+// ################################
+// ||                            ||
+// ||          POLICIES          ||
+// ||                            ||
+// ################################
+
+// Changes whenever `SC_PolicyState` or `SC_Policy` do, so plugins built
+// against another layout are refused instead of corrupting memory.
+#define SC_POLICY_ABI_VERSION 1
+
+/**
+ * What a scheduling policy sees of the simulation that drives it.
+ *
+ * Processes are referred to by their slot, every column has `count` values.
+ */
+typedef struct {
+  size_t count;
+  const SC_Time *arrival_time;
+  const SC_Time *burst_time;
+  const unsigned int *priority;
+  /** Time each process still has to run. */
+  const SC_Time *remaining_time;
+  /** Whatever the policy allocates on `init`. */
+  void *data;
+} SC_PolicyState;
+
+/**
+ * A scheduling policy, the decisions `simulate_policy` asks for.
+ *
+ * The engine owns the time, the timeline, the switch costs and the metrics, a
+ * policy only keeps the ready processes and says which one runs next.
+ * Every callback but `preempts` is required.
+ */
+typedef struct {
+  /** Unique name, the CLI and the UI refer to the policy by it. */
+  const char *name;
+  /** Every process is ready from time 0 instead of from its arrival. */
+  SC_Bool ignores_arrivals;
+  /** Allocates `state->data`. */
+  void (*init)(SC_PolicyState *state, SC_Err err);
+  /** Frees `state->data`, it's called even if `init` failed or didn't run. */
+  void (*deinit)(SC_PolicyState *state);
+  /** `slot` became ready at `time`. */
+  void (*admit)(SC_PolicyState *state, size_t slot, SC_Time time, SC_Err err);
+  /**
+   * Takes the process that runs next out of the ready ones, `SC_NO_SLOT` if
+   * none is ready.
+   */
+  size_t (*pick_next)(SC_PolicyState *state, SC_Time time);
+  /**
+   * `slot` starts making progress at `time`. Returns how long it may run
+   * before it's taken off the CPU, `SC_TIME_MAX` for as long as it needs.
+   */
+  SC_Time (*on_tick)(SC_PolicyState *state, size_t slot, SC_Time time);
+  /**
+   * `slot` was taken off the CPU at `time` before completing, because its
+   * time ran out or `preempts` said so. It's ready again, after the
+   * processes that arrived before `time` but before the ones arriving now.
+   */
+  void (*on_preempt)(SC_PolicyState *state, size_t slot, SC_Time time,
+                     SC_Err err);
+  /**
+   * Whether a ready process takes the CPU from `running` at `time`, it's
+   * asked on every event. `NULL` if the policy never preempts, then
+   * arrivals don't even interrupt the running process.
+   */
+  SC_Bool (*preempts)(SC_PolicyState *state, size_t running, SC_Time time);
+} SC_Policy;
+
+/**
+ * Exports the policies of a plugin, once per shared object:
+ *
+ * - `sc_policy_abi_version`, the `SC_POLICY_ABI_VERSION` it was built with.
+ * - `sc_policies`, its policies up to a `NULL`.
+ *
+ * The version is checked before anything else of the plugin is used.
+ */
+#define SC_POLICY_PLUGIN(...)                                                  \
+  const uint32_t sc_policy_abi_version = SC_POLICY_ABI_VERSION;                \
+  const SC_Policy *const sc_policies[] = {__VA_ARGS__, NULL}
+
+#endif
@@ -0,0 +1,225 @@
+#include "lib.c"
+#include <stdio.h>
+#include <stdlib.h>
+
+// ################################
+// ||                            ||
+// ||          HELPERS           ||
+// ||                            ||
+// ################################
+
+// Checks that failed so far, over every test.
+static size_t TEST_FAILED_CHECKS = 0;
+
+// Reports `condition` as a failure of the running test if it doesn't hold.
+#define TEST_CHECK(condition)                                                  \
+  do {                                                                         \
+    if (!(condition)) {                                                        \
+      fprintf(stderr, "%s:%d: FAILED: %s\n", __FILE__, __LINE__, #condition);  \
+      TEST_FAILED_CHECKS++;                                                    \
+    }                                                                          \
+  } while (0)
+
+/**
+ * Appends a process with one cycle per entry of `cpu_times`, every cycle
+ * but the last one sleeps on I/O for its entry of `io_times`.
+ */
+static void test_append_io_process(SC_ProcessTable *processes, size_t pid_idx,
+                                   const SC_Time *cpu_times,
+                                   const SC_Time *io_times, size_t cycle_count,
+                                   SC_Err err) {
+  SC_Process process = {
+      .pid_idx = pid_idx,
+      .first_cycle = processes->cycles.length,
+      .cycle_count = cycle_count,
+  };
+  for (size_t i = 0; i < cycle_count && *err == NO_ERROR; i++) {
+    SC_IoCycle cycle = {.cpu_time = cpu_times[i], .device = SC_IO_SLEEP};
+    if (i + 1 < cycle_count) {
+      cycle.io_time = io_times[i];
+    }
+    process.burst_time += cycle.cpu_time;
+    process.io_time += cycle.io_time;
+    SC_ProcessTable_AppendCycle(processes, cycle, err);
+  }
+  if (*err == NO_ERROR) {
+    SC_ProcessTable_Append(processes, process, err);
+  }
+}
+
+// ################################
+// ||                            ||
+// ||           TESTS            ||
+// ||                            ||
+// ################################
+
+// Timers that expire together pop in the order they were scheduled, even if
+// some of them cascaded from a higher level.
+static void test_timer_wheel_pops_ties_in_order(void) {
+  size_t err = NO_ERROR;
+  SC_TimerWheel wheel = {0};
+  SC_TimerWheel_Init(&wheel, 4, &err);
+  TEST_CHECK(err == NO_ERROR);
+  if (err != NO_ERROR) {
+    SC_TimerWheel_Deinit(&wheel);
+    return;
+  }
+
+  SC_TimerWheel_Schedule(&wheel, 2, 200);
+  SC_TimerWheel_Schedule(&wheel, 0, 200);
+  SC_TimerWheel_Advance(&wheel, 130);
+  SC_TimerWheel_Schedule(&wheel, 1, 200);
+  SC_TimerWheel_Advance(&wheel, 192);
+  SC_TimerWheel_Schedule(&wheel, 3, 200);
+  SC_TimerWheel_Advance(&wheel, 200);
+
+  size_t expected[] = {2, 0, 1, 3};
+  for (size_t i = 0; i < 4; i++) {
+    size_t id = wheel.capacity;
+    TEST_CHECK(SC_TimerWheel_Pop(&wheel, &id));
+    TEST_CHECK(id == expected[i]);
+  }
+  size_t id = wheel.capacity;
+  TEST_CHECK(!SC_TimerWheel_Pop(&wheel, &id));
+
+  SC_TimerWheel_Deinit(&wheel);
+}
+
+// Two processes that finish I/O at the same tick go back to the CPU in the
+// order they blocked.
+static void test_smp_wakes_simultaneous_io_in_order(void) {
+  size_t err = NO_ERROR;
+  SC_ProcessTable processes = {0};
+  SC_ProcessTable_Init(&processes, 2, &err);
+
+  // The first one runs from 0 to 2 and the second one from 2 to 5, both wake
+  // up at 8.
+  SC_Time first_cpu[] = {2, 1};
+  SC_Time first_io[] = {6};
+  SC_Time second_cpu[] = {3, 1};
+  SC_Time second_io[] = {3};
+  if (err == NO_ERROR) {
+    test_append_io_process(&processes, 0, first_cpu, first_io, 2, &err);
+  }
+  if (err == NO_ERROR) {
+    test_append_io_process(&processes, 1, second_cpu, second_io, 2, &err);
+  }
+
+  SC_Simulation sim = {.record_mode = SC_RECORD_STEPS};
+  SC_SmpConfig config = {.policy = SC_SMP_FIFO, .cpu_count = 1};
+  if (err == NO_ERROR) {
+    simulate_smp(&processes, &sim, &config, &err);
+  }
+  TEST_CHECK(err == NO_ERROR);
+
+  if (err == NO_ERROR) {
+    SC_Wakeup *wakeups = sim.wakeups.data;
+    TEST_CHECK(sim.wakeups.length == 2);
+    TEST_CHECK(wakeups[0].time == 8 && wakeups[0].pid_idx == 0);
+    TEST_CHECK(wakeups[1].time == 8 && wakeups[1].pid_idx == 1);
+    TEST_CHECK(sim.completion[0] == 9);
+    TEST_CHECK(sim.completion[1] == 10);
+  }
+
+  SC_Simulation_Deinit(&sim);
+  SC_ProcessTable_Deinit(&processes);
+}
+
+// Preemptive simulators still initialise and finish the simulation when
+// there are no processes, like the other ones.
+static void test_preemptive_simulators_finish_empty_tables(void) {
+  size_t err = NO_ERROR;
+  SC_ProcessTable processes = {0};
+  SC_ProcessTable_Init(&processes, 1, &err);
+
+  SC_Simulation srt = {.record_mode = SC_RECORD_STEPS};
+  SC_Simulation rr = {.record_mode = SC_RECORD_STEPS};
+  if (err == NO_ERROR) {
+    simulate_shortest_remaining(&processes, &srt, &err);
+  }
+  if (err == NO_ERROR) {
+    simulate_round_robin(&processes, &rr, 4, &err);
+  }
+  TEST_CHECK(err == NO_ERROR);
+
+  if (err == NO_ERROR) {
+    TEST_CHECK(NULL != srt.timelines && srt.timelines[0].length == 0);
+    TEST_CHECK(NULL != rr.timelines && rr.timelines[0].length == 0);
+    TEST_CHECK(srt.fairness == 1 && srt.cpu_efficiency == 1);
+    TEST_CHECK(rr.fairness == 1 && rr.cpu_efficiency == 1);
+  }
+
+  SC_Simulation_Deinit(&srt);
+  SC_Simulation_Deinit(&rr);
+  SC_ProcessTable_Deinit(&processes);
+}
+
+// A policy that can never allocate its state.
+static void test_failing_policy_init(SC_PolicyState *state, SC_Err err) {
+  (void)state;
+  *err = MALLOC_FAILED;
+}
+
+// A policy that fails to initialise still leaves the simulation initialised,
+// like a built-in simulator would.
+static void test_policy_init_failure_initialises_simulation(void) {
+  size_t err = NO_ERROR;
+  SC_ProcessTable processes = {0};
+  SC_ProcessTable_Init(&processes, 1, &err);
+  SC_Process process = {.pid_idx = 0, .burst_time = 3};
+  if (err == NO_ERROR) {
+    SC_ProcessTable_Append(&processes, process, &err);
+  }
+  TEST_CHECK(err == NO_ERROR);
+
+  SC_Policy policy = SC_FIFO_POLICY;
+  policy.init = test_failing_policy_init;
+  SC_Simulation sim = {.record_mode = SC_RECORD_STEPS};
+  if (err == NO_ERROR) {
+    simulate_policy(&processes, &sim, &policy, &err);
+    TEST_CHECK(err == MALLOC_FAILED);
+    TEST_CHECK(NULL != sim.timelines && sim.timelines[0].length == 0);
+  }
+
+  SC_Simulation_Deinit(&sim);
+  SC_ProcessTable_Deinit(&processes);
+}
+
+// ################################
+// ||                            ||
+// ||            MAIN            ||
+// ||                            ||
+// ################################
+
+typedef struct {
+  const char *name;
+  void (*run)(void);
+} Test;
+
+static const Test TESTS[] = {
+    {"timer_wheel_pops_ties_in_order", test_timer_wheel_pops_ties_in_order},
+    {"smp_wakes_simultaneous_io_in_order",
+     test_smp_wakes_simultaneous_io_in_order},
+    {"preemptive_simulators_finish_empty_tables",
+     test_preemptive_simulators_finish_empty_tables},
+    {"policy_init_failure_initialises_simulation",
+     test_policy_init_failure_initialises_simulation},
+};
+
+int main(void) {
+  size_t test_count = sizeof(TESTS) / sizeof(TESTS[0]);
+  size_t failed_tests = 0;
+  for (size_t i = 0; i < test_count; i++) {
+    size_t failed_checks = TEST_FAILED_CHECKS;
+    TESTS[i].run();
+    SC_Bool passed = failed_checks == TEST_FAILED_CHECKS;
+    fprintf(stdout, "%s %s\n", passed ? "PASS" : "FAIL", TESTS[i].name);
+    if (!passed) {
+      failed_tests++;
+    }
+  }
+
+  fprintf(stdout, "%zu of %zu tests passed.\n", test_count - failed_tests,
+          test_count);
+  return failed_tests > 0 ? 1 : 0;
+}